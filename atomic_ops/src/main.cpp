@@ -0,0 +1,230 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace atomic_ops
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    using OperationKernel = std::uint64_t (*)(std::uint64_t*, std::size_t);
+
+    struct OperationInfo
+    {
+        Operation operation;
+        OperationKernel latency_kernel;
+        OperationKernel throughput_kernel;
+    };
+
+    template <Operation OPERATION>
+    constexpr OperationInfo make_operation_info()
+    {
+        return {OPERATION, apply_operation<OPERATION, true>, apply_operation<OPERATION, false>};
+    }
+
+    constexpr auto OPERATIONS = std::array<OperationInfo, 10>{
+        make_operation_info<Operation::LoadRelaxed>(),
+        make_operation_info<Operation::LoadAcquire>(),
+        make_operation_info<Operation::LoadSeqCst>(),
+        make_operation_info<Operation::StoreRelaxed>(),
+        make_operation_info<Operation::StoreRelease>(),
+        make_operation_info<Operation::StoreSeqCst>(),
+        make_operation_info<Operation::FetchAdd>(),
+        make_operation_info<Operation::CompareExchange>(),
+        make_operation_info<Operation::Exchange>(),
+        make_operation_info<Operation::CompareExchange16>(),
+    };
+
+    constexpr auto PAIR_RELATIONS =
+        std::array<common::CpuRelation, 4>{common::CpuRelation::SmtSibling, common::CpuRelation::SharedL3,
+                                           common::CpuRelation::SamePackage, common::CpuRelation::RemotePackage};
+
+    // Threads that hammer the same line; `name` is a CPU relation for pairs, or "Spread" for the first N CPUs
+    struct ThreadPlacement
+    {
+        std::string name;
+        std::vector<std::int32_t> cpus;
+    };
+
+    struct BenchmarkResult
+    {
+        const Operation operation;
+        const std::string placement;
+        const std::size_t num_threads;
+        const bool dependent;
+        const std::size_t ops_per_thread;
+        std::int64_t elapsed_ns = std::numeric_limits<std::int64_t>::max();
+        std::uint64_t cycle_count = 0;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Operation,Placement,Threads,Dependent,OpsPerThread,Nanoseconds,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.operation) << "," << result.placement << "," << result.num_threads << ","
+                  << (result.dependent ? 1 : 0) << "," << result.ops_per_thread << "," << result.elapsed_ns << ","
+                  << result.cycle_count << "\n";
+    }
+
+    [[nodiscard]] std::vector<ThreadPlacement> build_placements(const std::vector<std::int32_t>& cpus)
+    {
+        const auto first = common::get_cpu_location(cpus.front());
+
+        auto placements = std::vector<ThreadPlacement>{{common::to_string(common::CpuRelation::Same), {cpus.front()}}};
+
+        for (const auto relation : PAIR_RELATIONS)
+        {
+            const auto it = std::find_if(cpus.begin(), cpus.end(), [&](const std::int32_t cpu) {
+                return common::get_cpu_relation(first, common::get_cpu_location(cpu)) == relation;
+            });
+            if (it != cpus.end())
+            {
+                placements.push_back({common::to_string(relation), {cpus.front(), *it}});
+            }
+        }
+
+        for (std::size_t num_threads = 4; num_threads < cpus.size(); num_threads *= 2)
+        {
+            const auto last = cpus.begin() + static_cast<std::ptrdiff_t>(num_threads);
+            placements.push_back({"Spread", std::vector<std::int32_t>(cpus.begin(), last)});
+        }
+        if (cpus.size() > 2)
+        {
+            placements.push_back({"Spread", cpus});
+        }
+
+        return placements;
+    }
+
+    // Cycle counter of one worker thread, opened by the thread itself before the measurement starts and closed once all
+    // workers have finished
+    class ThreadCycleCounter
+    {
+    public:
+        ThreadCycleCounter() = default;
+
+        ~ThreadCycleCounter()
+        {
+            if (counter_)
+            {
+                perf_counter_disable(&*counter_);
+                perf_counter_close(&*counter_);
+            }
+        }
+
+        ThreadCycleCounter(const ThreadCycleCounter&) = delete;
+        ThreadCycleCounter& operator=(const ThreadCycleCounter&) = delete;
+        ThreadCycleCounter(ThreadCycleCounter&&) = delete;
+        ThreadCycleCounter& operator=(ThreadCycleCounter&&) = delete;
+
+        void open()
+        {
+            auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+            if (!perf_counter_is_valid(&cycle_counter))
+            {
+                throw std::runtime_error(std::string("Failed to open performance counter for event '") +
+                                         CYCLES_EVENT + "'.");
+            }
+            counter_ = cycle_counter;
+            perf_counter_enable(&*counter_);
+        }
+
+        [[nodiscard]] std::uint64_t read() { return perf_counter_read(&*counter_); }
+
+    private:
+        std::optional<perf_counter> counter_;
+    };
+
+    // Runs the kernel on every CPU of the placement; the slowest thread's cycles are reported with the wall-clock time
+    void run_benchmark(const OperationKernel kernel, std::uint64_t* const target, const ThreadPlacement& placement,
+                       BenchmarkResult& result)
+    {
+        constexpr auto NUM_TRIALS = std::int32_t{5};
+        constexpr auto NUM_WARMUPS = std::int32_t{1};
+
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            auto cycle_counts = std::vector<std::uint64_t>(placement.cpus.size());
+            auto cycle_counters = std::vector<ThreadCycleCounter>(placement.cpus.size());
+            const auto elapsed_ns = common::run_pinned_threads(
+                placement.cpus, [&](const std::size_t thread_index) { cycle_counters[thread_index].open(); },
+                [&](const std::size_t thread_index) {
+                    auto& cycle_counter = cycle_counters[thread_index];
+
+                    const auto start_cycles = cycle_counter.read();
+                    static_cast<void>(kernel(target, result.ops_per_thread));
+                    const auto end_cycles = cycle_counter.read();
+
+                    cycle_counts[thread_index] = end_cycles - start_cycles;
+                });
+
+            if (i >= NUM_WARMUPS && elapsed_ns < result.elapsed_ns)
+            {
+                result.elapsed_ns = elapsed_ns;
+                result.cycle_count = *std::max_element(cycle_counts.begin(), cycle_counts.end());
+            }
+        }
+
+        print_csv_row(result);
+    }
+
+}  // namespace atomic_ops
+
+int main()
+{
+    constexpr auto OPS_PER_THREAD = std::size_t{1'000'000};
+
+    atomic_ops::print_csv_header();
+
+    try
+    {
+        const auto cpus = common::get_available_cpus();
+        const auto placements = atomic_ops::build_placements(cpus);
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+
+        // A dedicated cache line keeps cmpxchg16b aligned and free of unrelated traffic
+        auto target = common::allocate_aligned_buffer<std::uint64_t>(cache_line_bytes, cache_line_bytes);
+        std::memset(target.get(), 0, cache_line_bytes);
+
+        for (const auto& info : atomic_ops::OPERATIONS)
+        {
+            // Uncontended latency: a single thread with a dependency between consecutive operations
+            if (!atomic_ops::is_store(info.operation))
+            {
+                auto result = atomic_ops::BenchmarkResult{info.operation, placements.front().name, 1, true,
+                                                          OPS_PER_THREAD};
+                atomic_ops::run_benchmark(info.latency_kernel, target.get(), placements.front(), result);
+            }
+
+            // Throughput: independent operations from every thread of the placement to the same line
+            for (const auto& placement : placements)
+            {
+                auto result = atomic_ops::BenchmarkResult{info.operation, placement.name, placement.cpus.size(),
+                                                          false, OPS_PER_THREAD};
+                atomic_ops::run_benchmark(info.throughput_kernel, target.get(), placement, result);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace atomic_ops
+{
+    enum class Operation
+    {
+        LoadRelaxed,
+        LoadAcquire,
+        LoadSeqCst,
+        StoreRelaxed,
+        StoreRelease,
+        StoreSeqCst,
+        FetchAdd,
+        CompareExchange,
+        Exchange,
+        CompareExchange16,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Operation operation) noexcept
+    {
+        switch (operation)
+        {
+            case Operation::LoadRelaxed:
+                return "LoadRelaxed";
+            case Operation::LoadAcquire:
+                return "LoadAcquire";
+            case Operation::LoadSeqCst:
+                return "LoadSeqCst";
+            case Operation::StoreRelaxed:
+                return "StoreRelaxed";
+            case Operation::StoreRelease:
+                return "StoreRelease";
+            case Operation::StoreSeqCst:
+                return "StoreSeqCst";
+            case Operation::FetchAdd:
+                return "FetchAdd";
+            case Operation::CompareExchange:
+                return "CompareExchange";
+            case Operation::Exchange:
+                return "Exchange";
+            case Operation::CompareExchange16:
+                return "CompareExchange16";
+        }
+        return "Unknown";
+    }
+
+    [[nodiscard]] constexpr bool is_store(const Operation operation) noexcept
+    {
+        return operation == Operation::StoreRelaxed || operation == Operation::StoreRelease ||
+               operation == Operation::StoreSeqCst;
+    }
+
+    namespace detail
+    {
+        // lock cmpxchg16b; `target` must be 16-byte aligned
+        inline bool compare_exchange_16(std::uint64_t* const target, std::uint64_t& expected_low,
+                                        std::uint64_t& expected_high, const std::uint64_t desired_low,
+                                        const std::uint64_t desired_high) noexcept
+        {
+            bool success = false;
+            __asm__ volatile("lock cmpxchg16b %1"
+                             : "=@ccz"(success), "+m"(*target), "+a"(expected_low), "+d"(expected_high)
+                             : "b"(desired_low), "c"(desired_high)
+                             : "memory");
+            return success;
+        }
+    }  // namespace detail
+
+    // Applies `num_ops` operations to `target`. With `DEPENDENT`, every operation consumes the result of the previous
+    // one (through an opaque zero), so the loop measures latency rather than throughput. Stores produce no result and
+    // are always independent.
+    template <Operation OPERATION, bool DEPENDENT>
+    std::uint64_t apply_operation(std::uint64_t* const target, const std::size_t num_ops)
+    {
+        auto zero = std::uint64_t{0};
+        __asm__("" : "+r"(zero));
+
+        auto value = std::uint64_t{0};
+        auto high = std::uint64_t{0};
+        for (std::size_t i = 0; i < num_ops; ++i)
+        {
+            const auto operand = DEPENDENT ? (value & zero) + 1 : 1;
+
+            if constexpr (OPERATION == Operation::LoadRelaxed)
+            {
+                value += __atomic_load_n(target + (DEPENDENT ? value & zero : 0), __ATOMIC_RELAXED);
+            }
+            else if constexpr (OPERATION == Operation::LoadAcquire)
+            {
+                value += __atomic_load_n(target + (DEPENDENT ? value & zero : 0), __ATOMIC_ACQUIRE);
+            }
+            else if constexpr (OPERATION == Operation::LoadSeqCst)
+            {
+                value += __atomic_load_n(target + (DEPENDENT ? value & zero : 0), __ATOMIC_SEQ_CST);
+            }
+            else if constexpr (OPERATION == Operation::StoreRelaxed)
+            {
+                __atomic_store_n(target, i, __ATOMIC_RELAXED);
+            }
+            else if constexpr (OPERATION == Operation::StoreRelease)
+            {
+                __atomic_store_n(target, i, __ATOMIC_RELEASE);
+            }
+            else if constexpr (OPERATION == Operation::StoreSeqCst)
+            {
+                __atomic_store_n(target, i, __ATOMIC_SEQ_CST);
+            }
+            else if constexpr (OPERATION == Operation::FetchAdd)
+            {
+                value += __atomic_fetch_add(target, operand, __ATOMIC_SEQ_CST);
+            }
+            else if constexpr (OPERATION == Operation::CompareExchange)
+            {
+                // A failed attempt refreshes `value`, as in a CAS retry loop
+                __atomic_compare_exchange_n(target, &value, value + operand, false, __ATOMIC_SEQ_CST,
+                                            __ATOMIC_RELAXED);
+            }
+            else if constexpr (OPERATION == Operation::Exchange)
+            {
+                value += __atomic_exchange_n(target, operand, __ATOMIC_SEQ_CST);
+            }
+            else
+            {
+                detail::compare_exchange_16(target, value, high, value + operand, high);
+            }
+        }
+        return value + high;
+    }
+
+}  // namespace atomic_ops
@@ -0,0 +1,208 @@
+#include "common.hpp"
+#include "jit.hpp"
+#include "perf_counter.h"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace branch_predictor
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+    constexpr auto BRANCH_MISS_EVENT = "BRANCH-MISSES";
+
+    // Executions of the branch under test per trial
+    constexpr auto NUM_BRANCHES = std::size_t{1} << 20;
+
+    // Bytes between consecutive jump sites; several sites share a cache line so that the chains stress the BTB before
+    // the instruction cache
+    constexpr auto JUMP_SPACING = std::size_t{16};
+
+    constexpr auto DISPATCH_SEQUENCE_LENGTH = std::size_t{1} << 16;
+
+    constexpr auto RAND_SEED = std::uint64_t{12345};
+
+    // `parameter` is the period of a periodic conditional pattern, the number of jump sites of a chain, or the number
+    // of targets of the indirect dispatch. The misprediction penalty is the difference in cycles between the random and
+    // the always-taken conditional rows divided by the difference in branch misses.
+    struct BenchmarkResult
+    {
+        const Kernel kernel;
+        const Pattern pattern;
+        const std::size_t parameter;
+        const std::size_t num_branches;
+        std::uint64_t cycle_count = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t branch_miss_count = 0;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Kernel,Pattern,Parameter,NumBranches,Cycles,BranchMisses\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.kernel) << "," << to_string(result.pattern) << "," << result.parameter << ","
+                  << result.num_branches << "," << result.cycle_count << "," << result.branch_miss_count << "\n";
+    }
+
+    template <typename Function>
+    void run_benchmark(BenchmarkResult result, Function&& function)
+    {
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        auto branch_miss_counter = perf_counter_open_by_name(BRANCH_MISS_EVENT, cycle_counter.fd);
+        if (!perf_counter_is_valid(&branch_miss_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << BRANCH_MISS_EVENT << "'.\n";
+            perf_counter_close(&cycle_counter);
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_branch_misses = perf_counter_read(&branch_miss_counter);
+            const auto start_cycles = perf_counter_read(&cycle_counter);
+
+            function();
+
+            const auto end_cycles = perf_counter_read(&cycle_counter);
+            const auto end_branch_misses = perf_counter_read(&branch_miss_counter);
+
+            const auto cycles = end_cycles - start_cycles;
+            if (i >= NUM_WARMUPS && cycles < result.cycle_count)
+            {
+                result.cycle_count = cycles;
+                result.branch_miss_count = end_branch_misses - start_branch_misses;
+            }
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&branch_miss_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+    void run_conditional_benchmark(const Pattern pattern, const std::size_t period)
+    {
+        const auto conditions = generate_conditions(pattern, period, NUM_BRANCHES, RAND_SEED);
+
+        run_benchmark(BenchmarkResult{Kernel::Conditional, pattern, period, NUM_BRANCHES}, [&]() {
+            static_cast<void>(execute_conditional_branches(conditions.data(), conditions.size()));
+        });
+    }
+
+    template <typename Emitter>
+    void run_jump_chain_benchmark(const Kernel kernel, const std::size_t num_sites, Emitter&& emitter)
+    {
+        constexpr auto CODE_SLACK = std::size_t{4096};
+
+        auto buffer = common::JitBuffer(num_sites * JUMP_SPACING + CODE_SLACK, false);
+        const auto jit_kernel = emitter(buffer, num_sites, JUMP_SPACING);
+        const auto num_iterations = std::max<std::size_t>(1, NUM_BRANCHES / num_sites);
+
+        run_benchmark(BenchmarkResult{kernel, Pattern::AlwaysTaken, num_sites, num_iterations * num_sites}, [&]() {
+            jit_kernel.function(num_iterations, jit_kernel.table.data(), 0);
+        });
+    }
+
+    void run_dispatch_benchmark(const Pattern pattern, const std::size_t num_targets)
+    {
+        constexpr auto CODE_SLACK = std::size_t{4096};
+
+        auto rng = std::mt19937_64(RAND_SEED);
+        auto sequence = std::vector<std::size_t>(DISPATCH_SEQUENCE_LENGTH);
+        if (pattern == Pattern::Random)
+        {
+            auto distribution = std::uniform_int_distribution<std::size_t>(0, num_targets - 1);
+            for (auto& target : sequence)
+            {
+                target = distribution(rng);
+            }
+        }
+        else
+        {
+            // Every target once per period, in a shuffled order
+            auto cycle = std::vector<std::size_t>(num_targets);
+            std::iota(cycle.begin(), cycle.end(), 0);
+            std::shuffle(cycle.begin(), cycle.end(), rng);
+            for (std::size_t i = 0; i < sequence.size(); ++i)
+            {
+                sequence[i] = cycle[i % num_targets];
+            }
+        }
+
+        auto buffer = common::JitBuffer(num_targets * CODE_ALIGNMENT + CODE_SLACK, false);
+        const auto jit_kernel = emit_indirect_dispatch(buffer, num_targets, sequence);
+
+        run_benchmark(BenchmarkResult{Kernel::IndirectDispatch, pattern, num_targets, NUM_BRANCHES}, [&]() {
+            jit_kernel.function(NUM_BRANCHES, jit_kernel.table.data(), jit_kernel.table.size() - 1);
+        });
+    }
+
+}  // namespace branch_predictor
+
+int main()
+{
+    using branch_predictor::Kernel;
+    using branch_predictor::Pattern;
+
+    constexpr auto MIN_JUMP_SITES = std::size_t{16};
+    constexpr auto MAX_JUMP_SITES = 64 * common::KiB;
+
+    branch_predictor::print_csv_header();
+
+    try
+    {
+        // Misprediction penalty
+        branch_predictor::run_conditional_benchmark(Pattern::AlwaysTaken, 0);
+        branch_predictor::run_conditional_benchmark(Pattern::Random, 0);
+
+        // Pattern-history length: the miss rate rises once the period exceeds what the predictor can track
+        for (std::size_t period = 2; period <= 64 * common::KiB; period *= 2)  // NOLINT(readability-magic-numbers)
+        {
+            branch_predictor::run_conditional_benchmark(Pattern::Periodic, period);
+        }
+
+        // BTB capacity
+        for (auto num_sites = MIN_JUMP_SITES; num_sites <= MAX_JUMP_SITES; num_sites *= 2)
+        {
+            branch_predictor::run_jump_chain_benchmark(Kernel::DirectJumpChain, num_sites,
+                                                       branch_predictor::emit_direct_jump_chain);
+            branch_predictor::run_jump_chain_benchmark(Kernel::IndirectJumpChain, num_sites,
+                                                       branch_predictor::emit_indirect_jump_chain);
+        }
+
+        // Indirect target prediction for a single polymorphic site
+        for (std::size_t num_targets = 1; num_targets <= 256; num_targets *= 2)  // NOLINT(readability-magic-numbers)
+        {
+            branch_predictor::run_dispatch_benchmark(Pattern::Periodic, num_targets);
+            branch_predictor::run_dispatch_benchmark(Pattern::Random, num_targets);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "jit.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace branch_predictor
+{
+    enum class Kernel
+    {
+        Conditional,
+        DirectJumpChain,
+        IndirectJumpChain,
+        IndirectDispatch,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Kernel kernel) noexcept
+    {
+        switch (kernel)
+        {
+            case Kernel::Conditional:
+                return "Conditional";
+            case Kernel::DirectJumpChain:
+                return "DirectJumpChain";
+            case Kernel::IndirectJumpChain:
+                return "IndirectJumpChain";
+            case Kernel::IndirectDispatch:
+                return "IndirectDispatch";
+        }
+        return "Unknown";
+    }
+
+    enum class Pattern
+    {
+        // The branch always goes the same way (or to the same target)
+        AlwaysTaken,
+        // A random sequence of outcomes (or targets) repeated with a fixed period
+        Periodic,
+        // Independent random outcomes (or targets) with no period the predictor could learn
+        Random,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Pattern pattern) noexcept
+    {
+        switch (pattern)
+        {
+            case Pattern::AlwaysTaken:
+                return "AlwaysTaken";
+            case Pattern::Periodic:
+                return "Periodic";
+            case Pattern::Random:
+                return "Random";
+        }
+        return "Unknown";
+    }
+
+    // One byte per branch execution: non-zero means taken. A periodic pattern is half taken, shuffled within a period,
+    // and `num_conditions` must be a multiple of `period` so that the sequence wraps around seamlessly.
+    [[nodiscard]] inline std::vector<std::uint8_t> generate_conditions(const Pattern pattern, const std::size_t period,
+                                                                       const std::size_t num_conditions,
+                                                                       const std::uint64_t seed)
+    {
+        auto conditions = std::vector<std::uint8_t>(num_conditions, 1);
+        auto rng = std::mt19937_64(seed);
+
+        if (pattern == Pattern::Periodic)
+        {
+            if (period == 0 || num_conditions % period != 0)
+            {
+                throw std::invalid_argument("`num_conditions` must be a multiple of `period`.");
+            }
+
+            auto cycle = std::vector<std::uint8_t>(period, 0);
+            std::fill(cycle.begin(), cycle.begin() + static_cast<std::ptrdiff_t>(period / 2), 1);
+            std::shuffle(cycle.begin(), cycle.end(), rng);
+            for (std::size_t i = 0; i < num_conditions; ++i)
+            {
+                conditions[i] = cycle[i % period];
+            }
+        }
+        else if (pattern == Pattern::Random)
+        {
+            auto distribution = std::bernoulli_distribution(0.5);
+            for (auto& condition : conditions)
+            {
+                condition = distribution(rng) ? 1 : 0;
+            }
+        }
+
+        return conditions;
+    }
+
+    // Executes one conditional branch per condition; it skips an increment when taken so that it cannot become a cmov
+    inline std::uint64_t execute_conditional_branches(const std::uint8_t* const conditions,
+                                                      const std::size_t num_conditions) noexcept
+    {
+        auto num_not_taken = std::uint64_t{0};
+        for (std::size_t i = 0; i < num_conditions; ++i)
+        {
+            __asm__ volatile(
+                "test %[condition], %[condition]\n\t"
+                "jnz 1f\n\t"
+                "add $1, %[count]\n\t"
+                "1:\n\t"
+                : [count] "+r"(num_not_taken)
+                : [condition] "r"(conditions[i])
+                : "cc");
+        }
+        return num_not_taken;
+    }
+
+    // Generated code takes the iteration count, a table of 64-bit addresses and the table index mask
+    using JitFunction = void (*)(std::uint64_t num_iterations, const std::uint64_t* table, std::uint64_t mask);
+
+    struct JitKernel
+    {
+        JitFunction function;
+        std::vector<std::uint64_t> table;
+    };
+
+    // Generated kernels, and each target of the indirect dispatch, start on this boundary
+    constexpr auto CODE_ALIGNMENT = std::size_t{64};
+
+    namespace detail
+    {
+        constexpr auto INT3 = std::uint8_t{0xCC};
+
+        // dec %rdi; jnz <loop_offset>; ret
+        inline void emit_loop_tail(common::JitBuffer& buffer, const std::size_t loop_offset)
+        {
+            buffer.emit({0x48, 0xFF, 0xCF});
+            buffer.emit({0x0F, 0x85});
+            buffer.emit_rel32(loop_offset);
+            buffer.emit({0xC3});
+        }
+
+        inline void validate_spacing(const std::size_t spacing)
+        {
+            constexpr auto MIN_SPACING = std::size_t{8};
+            if (spacing < MIN_SPACING)
+            {
+                throw std::invalid_argument("`spacing` must be at least " + std::to_string(MIN_SPACING) + " bytes.");
+            }
+        }
+    }  // namespace detail
+
+    // `num_sites` unconditional direct jumps, `spacing` bytes apart, each jumping to the next one. Once the sites
+    // outnumber the BTB entries, every jump is only discovered at decode.
+    [[nodiscard]] inline JitKernel emit_direct_jump_chain(common::JitBuffer& buffer, const std::size_t num_sites,
+                                                          const std::size_t spacing)
+    {
+        detail::validate_spacing(spacing);
+        buffer.align(CODE_ALIGNMENT, detail::INT3);
+
+        const auto start = buffer.size();
+        const auto tail = start + (num_sites * spacing);
+        for (std::size_t i = 0; i < num_sites; ++i)
+        {
+            // jmp <next site>
+            buffer.pad_to(start + (i * spacing), detail::INT3);
+            buffer.emit({0xE9});
+            buffer.emit_rel32(i + 1 < num_sites ? start + ((i + 1) * spacing) : tail);
+        }
+        buffer.pad_to(tail, detail::INT3);
+        detail::emit_loop_tail(buffer, start);
+
+        buffer.finalize();
+        return {buffer.get_function<JitFunction>(start), {}};
+    }
+
+    // Same layout as the direct chain, but every site is an indirect jump through its own table entry, so each site
+    // has a single target that only the BTB (not the decoder) can supply
+    [[nodiscard]] inline JitKernel emit_indirect_jump_chain(common::JitBuffer& buffer, const std::size_t num_sites,
+                                                            const std::size_t spacing)
+    {
+        detail::validate_spacing(spacing);
+        buffer.align(CODE_ALIGNMENT, detail::INT3);
+
+        const auto start = buffer.size();
+        const auto tail = start + (num_sites * spacing);
+        auto table = std::vector<std::uint64_t>(num_sites);
+        for (std::size_t i = 0; i < num_sites; ++i)
+        {
+            // jmp *disp32(%rsi)
+            buffer.pad_to(start + (i * spacing), detail::INT3);
+            buffer.emit({0xFF, 0xA6});
+            buffer.emit_u32(static_cast<std::uint32_t>(i * sizeof(std::uint64_t)));
+            table[i] = buffer.address_of(i + 1 < num_sites ? start + ((i + 1) * spacing) : tail);
+        }
+        buffer.pad_to(tail, detail::INT3);
+        detail::emit_loop_tail(buffer, start);
+
+        buffer.finalize();
+        return {buffer.get_function<JitFunction>(start), std::move(table)};
+    }
+
+    // A single indirect jump that walks `target_sequence` (indices into `num_targets` targets, power-of-2 length);
+    // each target jumps straight back to the loop tail
+    [[nodiscard]] inline JitKernel emit_indirect_dispatch(common::JitBuffer& buffer, const std::size_t num_targets,
+                                                          const std::vector<std::size_t>& target_sequence)
+    {
+        if (target_sequence.empty() || (target_sequence.size() & (target_sequence.size() - 1)) != 0)
+        {
+            throw std::invalid_argument("The length of `target_sequence` must be a power of 2.");
+        }
+
+        buffer.align(CODE_ALIGNMENT, detail::INT3);
+        const auto start = buffer.size();
+
+        // xor %ecx, %ecx
+        buffer.emit({0x31, 0xC9});
+
+        // mov (%rsi,%rcx,8), %rax; inc %rcx; and %rdx, %rcx; jmp *%rax
+        const auto loop = buffer.size();
+        buffer.emit({0x48, 0x8B, 0x04, 0xCE});
+        buffer.emit({0x48, 0xFF, 0xC1});
+        buffer.emit({0x48, 0x21, 0xD1});
+        buffer.emit({0xFF, 0xE0});
+
+        buffer.align(CODE_ALIGNMENT, detail::INT3);
+        const auto targets = buffer.size();
+        const auto tail = targets + (num_targets * CODE_ALIGNMENT);
+        for (std::size_t i = 0; i < num_targets; ++i)
+        {
+            // jmp <tail>
+            buffer.pad_to(targets + (i * CODE_ALIGNMENT), detail::INT3);
+            buffer.emit({0xE9});
+            buffer.emit_rel32(tail);
+        }
+        buffer.pad_to(tail, detail::INT3);
+        detail::emit_loop_tail(buffer, loop);
+
+        auto table = std::vector<std::uint64_t>(target_sequence.size());
+        for (std::size_t i = 0; i < target_sequence.size(); ++i)
+        {
+            if (target_sequence[i] >= num_targets)
+            {
+                throw std::out_of_range("`target_sequence` refers to a target that does not exist.");
+            }
+            table[i] = buffer.address_of(targets + (target_sequence[i] * CODE_ALIGNMENT));
+        }
+
+        buffer.finalize();
+        return {buffer.get_function<JitFunction>(start), std::move(table)};
+    }
+
+}  // namespace branch_predictor
@@ -0,0 +1,274 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cache_replacement
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+#ifdef __znver2__
+    constexpr auto L1D_MISS_EVENT =
+        "amd64_fam17h_zen2::DATA_CACHE_REFILLS_FROM_SYSTEM"
+        ":MABRESP_LCL_L2"
+        ":LS_MABRESP_LCL_CACHE"
+        ":LS_MABRESP_LCL_DRAM"
+        ":LS_MABRESP_RMT_CACHE"
+        ":LS_MABRESP_RMT_DRAM";
+    constexpr auto L2_MISS_EVENT =
+        "amd64_fam17h_zen2::DATA_CACHE_REFILLS_FROM_SYSTEM"
+        ":LS_MABRESP_LCL_CACHE"
+        ":LS_MABRESP_LCL_DRAM"
+        ":LS_MABRESP_RMT_CACHE"
+        ":LS_MABRESP_RMT_DRAM";
+    constexpr auto L3_MISS_EVENT =
+        "amd64_fam17h_zen2::DATA_CACHE_REFILLS_FROM_SYSTEM"
+        ":LS_MABRESP_LCL_DRAM"
+        ":LS_MABRESP_RMT_DRAM";
+#else
+    // The generic events have no L2 level; where the model-specific L2 event is missing too, the L2 and L3 hit rates
+    // cannot be told apart and are reported as NA
+    constexpr auto L1D_MISS_EVENT = "L1-DCACHE-LOAD-MISSES";
+    constexpr auto L2_MISS_EVENT = "MEM_LOAD_RETIRED:L2_MISS";
+    constexpr auto L3_MISS_EVENT = "LLC-LOAD-MISSES";
+#endif
+
+    // Laps of the hot set before each scan, enough to settle it into the caches
+    constexpr auto NUM_WARMUP_LAPS = std::size_t{4};
+
+    struct BenchmarkResult
+    {
+        const Pattern pattern;
+        const ScanHint hint;
+        const std::size_t hot_size;
+        const std::size_t cold_size;
+        const std::size_t num_hot_loads;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+        std::uint64_t l1d_miss_count = 0;
+        std::optional<std::uint64_t> l2_miss_count = std::nullopt;
+        std::uint64_t l3_miss_count = 0;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Pattern,ScanHint,HotSize,ColdSize,NumHotLoads,Cycles,L1DHitRate,L2HitRate,L3HitRate,DramRate\n";
+    }
+
+    // Rates are fractions of all hot loads, so the four of them sum to 1
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        const auto num_loads = static_cast<double>(result.num_hot_loads);
+        const auto l1d_misses = static_cast<double>(result.l1d_miss_count);
+        const auto l3_misses = static_cast<double>(result.l3_miss_count);
+
+        std::cout << to_string(result.pattern) << "," << to_string(result.hint) << "," << result.hot_size << ","
+                  << result.cold_size << "," << result.num_hot_loads << "," << result.cycle_count << ","
+                  << (num_loads - l1d_misses) / num_loads << ",";
+        if (result.l2_miss_count)
+        {
+            const auto l2_misses = static_cast<double>(*result.l2_miss_count);
+            std::cout << (l1d_misses - l2_misses) / num_loads << "," << (l2_misses - l3_misses) / num_loads;
+        }
+        else
+        {
+            std::cout << "NA,NA";
+        }
+        std::cout << "," << l3_misses / num_loads << "\n";
+    }
+
+    // Whether the L2 miss event can be counted on this CPU; it is model-specific outside Zen 2
+    [[nodiscard]] bool can_count_l2_misses()
+    {
+        auto counter = perf_counter_open_by_name(L2_MISS_EVENT, -1);
+        if (!perf_counter_is_valid(&counter))
+        {
+            return false;
+        }
+        perf_counter_close(&counter);
+        return true;
+    }
+
+    // Warms the hot chain, runs `scan`, then counts the misses of a single lap of the hot chain. L2 misses are only
+    // counted when `count_l2_misses`.
+    template <typename Scan>
+    void run_benchmark(const Pattern pattern, const ScanHint hint, const std::size_t hot_size,
+                       const std::size_t cold_size, common::MemoryAddress* const hot_start,
+                       const std::size_t num_hot_lines, const bool count_l2_misses, Scan&& scan)
+    {
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+
+        const auto open_counter = [](const char* name, const std::int32_t group_fd) {
+            const auto counter = perf_counter_open_by_name(name, group_fd);
+            if (!perf_counter_is_valid(&counter))
+            {
+                throw std::runtime_error("Failed to open performance counter for event '" + std::string(name) + "'.");
+            }
+            return counter;
+        };
+
+        auto cycle_counter = open_counter(CYCLES_EVENT, -1);
+        auto l1d_miss_counter = open_counter(L1D_MISS_EVENT, cycle_counter.fd);
+        auto l2_miss_counter =
+            count_l2_misses ? std::optional<perf_counter>(open_counter(L2_MISS_EVENT, cycle_counter.fd)) : std::nullopt;
+        auto l3_miss_counter = open_counter(L3_MISS_EVENT, cycle_counter.fd);
+
+        auto result = BenchmarkResult{pattern, hint, hot_size, cold_size, num_hot_lines};
+
+        perf_counter_enable(&cycle_counter);
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            walk_pointer_chain(hot_start, NUM_WARMUP_LAPS * num_hot_lines);
+            scan();
+
+            const auto start_l1d_misses = perf_counter_read(&l1d_miss_counter);
+            const auto start_l2_misses = l2_miss_counter ? perf_counter_read(&*l2_miss_counter) : 0;
+            const auto start_l3_misses = perf_counter_read(&l3_miss_counter);
+            const auto start_cycles = perf_counter_read(&cycle_counter);
+
+            walk_pointer_chain(hot_start, num_hot_lines);
+
+            const auto end_cycles = perf_counter_read(&cycle_counter);
+            const auto end_l3_misses = perf_counter_read(&l3_miss_counter);
+            const auto end_l2_misses = l2_miss_counter ? perf_counter_read(&*l2_miss_counter) : 0;
+            const auto end_l1d_misses = perf_counter_read(&l1d_miss_counter);
+
+            const auto cycles = end_cycles - start_cycles;
+            if (i >= NUM_WARMUPS && cycles < result.cycle_count)
+            {
+                result.cycle_count = cycles;
+                result.l1d_miss_count = end_l1d_misses - start_l1d_misses;
+                if (l2_miss_counter)
+                {
+                    result.l2_miss_count = end_l2_misses - start_l2_misses;
+                }
+                result.l3_miss_count = end_l3_misses - start_l3_misses;
+            }
+        }
+        perf_counter_disable(&cycle_counter);
+
+        perf_counter_close(&l3_miss_counter);
+        if (l2_miss_counter)
+        {
+            perf_counter_close(&*l2_miss_counter);
+        }
+        perf_counter_close(&l1d_miss_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+}  // namespace cache_replacement
+
+// Reading the results:
+// - ScanResistance: hit rates of the hot set that survive a scan of each size, with and without non-temporal hints.
+// - BackInvalidation: a DRAM rate that grows with the scan size means an inclusive L3, whose evictions take the hot set
+//   out of the L2 as well; a non-inclusive or victim L3 keeps the hot set in the L2, so its loads never reach DRAM.
+// - EffectiveCapacity: a DRAM rate that stays low past the L3 size means a victim (exclusive) L3, whose capacity adds
+//   to the L2's.
+int main()
+{
+    using cache_replacement::Pattern;
+    using cache_replacement::ScanHint;
+
+    constexpr auto RAND_SEED = std::uint64_t{12345};
+
+    cache_replacement::print_csv_header();
+
+    try
+    {
+        common::pin_current_thread_to_cpu(common::get_available_cpus().front());
+
+        const auto line_size = common::get_cache_line_bytes();
+        const auto hugepage_size = common::get_hugepage_size();
+        const auto geometry = cache_replacement::get_cache_geometry();
+
+        const auto count_l2_misses = cache_replacement::can_count_l2_misses();
+        if (!count_l2_misses)
+        {
+            std::cerr << "Warning: Event '" << cache_replacement::L2_MISS_EVENT
+                      << "' is not available; L2HitRate and L3HitRate are NA.\n";
+        }
+
+        const auto cold_sizes = std::vector<std::size_t>{0, geometry.l3_size / 4, geometry.l3_size / 2,
+                                                         geometry.l3_size, 2 * geometry.l3_size};
+
+        // Twice the largest scan, since `BackInvalidation` only reads the upper half of every L2 way
+        const auto cold_buffer_size = 2 * cold_sizes.back();
+        auto cold_buffer = common::allocate_aligned_buffer<unsigned char>(cold_buffer_size, hugepage_size);
+        common::advise_hugepage(cold_buffer.get(), cold_buffer_size, true);
+        std::memset(cold_buffer.get(), 0, cold_buffer_size);
+
+        for (const auto hot_size : {geometry.l1d_size / 2, geometry.l2_size / 2, geometry.l3_size / 2})
+        {
+            auto buffer = common::allocate_aligned_buffer<common::MemoryAddress>(hot_size, hugepage_size);
+            common::advise_hugepage(buffer.get(), hot_size, true);
+            const auto num_lines = hot_size / line_size;
+            auto* const start_ptr =
+                common::generate_random_pointer_chasing(buffer.get(), num_lines, line_size, RAND_SEED);
+
+            for (const auto hint : {ScanHint::None, ScanHint::NonTemporal})
+            {
+                for (const auto cold_size : cold_sizes)
+                {
+                    cache_replacement::run_benchmark(
+                        Pattern::ScanResistance, hint, hot_size, cold_size, start_ptr, num_lines, count_l2_misses, [&] {
+                            cache_replacement::scan(cold_buffer.get(), cold_size, cold_size, 0, cold_size, line_size,
+                                                    hint);
+                        });
+                }
+            }
+        }
+
+        {
+            const auto hot_buffer_size = geometry.l2_num_ways * geometry.l2_bytes_per_way;
+            auto buffer = common::allocate_aligned_buffer<unsigned char>(hot_buffer_size, hugepage_size);
+            common::advise_hugepage(buffer.get(), hot_buffer_size, true);
+            const auto lines = cache_replacement::get_lower_set_lines(buffer.get(), geometry, line_size);
+            auto* const start_ptr = common::link_random_pointer_chasing(lines, RAND_SEED);
+
+            const auto way_size = geometry.l2_bytes_per_way;
+            for (const auto cold_size : cold_sizes)
+            {
+                cache_replacement::run_benchmark(
+                    Pattern::BackInvalidation, ScanHint::None, lines.size() * line_size, cold_size, start_ptr,
+                    lines.size(), count_l2_misses, [&] {
+                        cache_replacement::scan(cold_buffer.get(), 2 * cold_size, way_size, way_size / 2, way_size,
+                                                line_size, ScanHint::None);
+                    });
+            }
+        }
+
+        // From one L2 below the L3 size to two above it, in steps of half the L2
+        const auto step = geometry.l2_size / 2;
+        for (auto size = geometry.l3_size > geometry.l2_size ? geometry.l3_size - geometry.l2_size : step;
+             size <= geometry.l3_size + (2 * geometry.l2_size); size += step)
+        {
+            auto buffer = common::allocate_aligned_buffer<common::MemoryAddress>(size, hugepage_size);
+            common::advise_hugepage(buffer.get(), size, true);
+            const auto num_lines = size / line_size;
+            auto* const start_ptr =
+                common::generate_random_pointer_chasing(buffer.get(), num_lines, line_size, RAND_SEED);
+
+            cache_replacement::run_benchmark(Pattern::EffectiveCapacity, ScanHint::None, size, 0, start_ptr,
+                                             num_lines, count_l2_misses, [] {});
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "pointer_chasing.hpp"
+
+#include <unistd.h>
+#include <x86intrin.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace cache_replacement
+{
+    enum class Pattern
+    {
+        // Warm a hot set sized to half of a level, scan a cold buffer, then chase the hot set once
+        ScanResistance,
+        // Like `ScanResistance`, but the hot set and the scan use disjoint halves of the L2 sets, so only an L3 that
+        // back-invalidates the L2 can evict the hot set
+        BackInvalidation,
+        // Chase a set around the L3 size with no scan; a victim or exclusive L3 keeps hitting up to the L2 plus L3
+        EffectiveCapacity,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Pattern pattern) noexcept
+    {
+        switch (pattern)
+        {
+            case Pattern::ScanResistance:
+                return "ScanResistance";
+            case Pattern::BackInvalidation:
+                return "BackInvalidation";
+            case Pattern::EffectiveCapacity:
+                return "EffectiveCapacity";
+        }
+        return "Unknown";
+    }
+
+    enum class ScanHint
+    {
+        None,
+        // prefetchnta ahead of the loads, as a scan operator with non-temporal hints would issue
+        NonTemporal,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const ScanHint hint) noexcept
+    {
+        switch (hint)
+        {
+            case ScanHint::None:
+                return "None";
+            case ScanHint::NonTemporal:
+                return "NonTemporal";
+        }
+        return "Unknown";
+    }
+
+    struct CacheGeometry
+    {
+        std::size_t l1d_size;
+        std::size_t l2_size;
+        std::size_t l3_size;
+        // Distance between consecutive lines that map to the same L2 set
+        std::size_t l2_bytes_per_way;
+        std::size_t l2_num_ways;
+    };
+
+    [[nodiscard]] inline CacheGeometry get_cache_geometry()
+    {
+        const auto l1d_size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+        const auto l2_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        const auto l2_ways = sysconf(_SC_LEVEL2_CACHE_ASSOC);
+        const auto l3_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        if (l1d_size < 1 || l2_size < 1 || l2_ways < 1 || l3_size < 1)
+        {
+            throw std::runtime_error("Failed to get the cache geometry.");
+        }
+        return {static_cast<std::size_t>(l1d_size), static_cast<std::size_t>(l2_size),
+                static_cast<std::size_t>(l3_size), static_cast<std::size_t>(l2_size / l2_ways),
+                static_cast<std::size_t>(l2_ways)};
+    }
+
+    // Hot set of `BackInvalidation`: the lines of the lower half of the L2 sets in three quarters of the ways, so that
+    // it fits the L2 with room to spare. The buffer must be hugepage-backed for the virtual set index to be physical.
+    [[nodiscard]] inline std::vector<common::MemoryAddress*> get_lower_set_lines(unsigned char* const buffer,
+                                                                                 const CacheGeometry& geometry,
+                                                                                 const std::size_t line_size)
+    {
+        auto lines = std::vector<common::MemoryAddress*>();
+        for (std::size_t way = 0; way < (geometry.l2_num_ways * 3) / 4; ++way)
+        {
+            for (std::size_t offset = 0; offset < geometry.l2_bytes_per_way / 2; offset += line_size)
+            {
+                auto* const line = buffer + (way * geometry.l2_bytes_per_way) + offset;
+                lines.push_back(reinterpret_cast<common::MemoryAddress*>(line));
+            }
+        }
+        return lines;
+    }
+
+    // Chases a chain for a number of steps only known at run time
+    inline common::MemoryAddress* walk_pointer_chain(common::MemoryAddress* const start_ptr,
+                                                     const std::size_t num_steps)
+    {
+        auto* current_ptr = start_ptr;
+        for (std::size_t i = 0; i < num_steps; ++i)
+        {
+            // current_ptr = *current_ptr
+            __asm__ volatile("mov (%0), %0\n\t" : "+r"(current_ptr) : : "memory");
+        }
+        return current_ptr;
+    }
+
+    // Loads one word of each line in bytes [`first_byte`, `last_byte`) of every `block_size`-byte block of the buffer,
+    // in address order. Returns the number of lines loaded.
+    inline std::size_t scan(const unsigned char* const buffer, const std::size_t buffer_size,
+                            const std::size_t block_size, const std::size_t first_byte, const std::size_t last_byte,
+                            const std::size_t line_size, const ScanHint hint)
+    {
+        // Far enough ahead to cover the memory latency at streaming rates
+        constexpr auto PREFETCH_DISTANCE = std::size_t{16};
+
+        auto num_lines = std::size_t{0};
+        for (std::size_t block = 0; block < buffer_size; block += block_size)
+        {
+            for (auto offset = first_byte; offset < last_byte; offset += line_size)
+            {
+                const auto* const line = buffer + block + offset;
+                if (hint == ScanHint::NonTemporal && offset + (PREFETCH_DISTANCE * line_size) < last_byte)
+                {
+                    _mm_prefetch(reinterpret_cast<const char*>(line + (PREFETCH_DISTANCE * line_size)), _MM_HINT_NTA);
+                }
+                static_cast<void>(*reinterpret_cast<const volatile std::uint64_t*>(line));
+                ++num_lines;
+            }
+        }
+        return num_lines;
+    }
+
+}  // namespace cache_replacement
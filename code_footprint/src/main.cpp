@@ -0,0 +1,146 @@
+#include "common.hpp"
+#include "jit.hpp"
+#include "perf_counter.h"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+
+namespace code_footprint
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+    constexpr auto L1I_MISS_EVENT = "L1-ICACHE-LOAD-MISSES";
+    constexpr auto ITLB_MISS_EVENT = "ITLB-LOAD-MISSES";
+
+    struct BenchmarkResult
+    {
+        const Layout layout;
+        const std::size_t footprint;
+        const std::size_t page_size;
+        std::size_t num_instructions = 0;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+        std::uint64_t l1i_miss_count = 0;
+        std::uint64_t itlb_miss_count = 0;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Layout,Footprint,PageSize,NumInstructions,Cycles,L1IMisses,ITLBMisses\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.layout) << "," << result.footprint << "," << result.page_size << ","
+                  << result.num_instructions << "," << result.cycle_count << "," << result.l1i_miss_count << ","
+                  << result.itlb_miss_count << "\n";
+    }
+
+    void run_benchmark(const Layout layout, const std::size_t footprint_bytes, const bool use_hugepage)
+    {
+        constexpr auto MIN_INSTRUCTIONS = std::size_t{10'000'000};
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+
+        // Room for the loop tail after the footprint
+        auto buffer = common::JitBuffer(footprint_bytes + CODE_PAGE_SIZE, use_hugepage);
+        const auto code = generate_code(buffer, layout, footprint_bytes);
+        const auto num_iterations = std::max<std::size_t>(1, MIN_INSTRUCTIONS / code.instructions_per_iteration);
+
+        const auto page_size = use_hugepage ? common::get_hugepage_size() : common::get_page_size();
+        auto result = BenchmarkResult{layout, footprint_bytes, page_size};
+        result.num_instructions = num_iterations * code.instructions_per_iteration;
+
+        const auto open_counter = [](const char* name, const std::int32_t group_fd) {
+            const auto counter = perf_counter_open_by_name(name, group_fd);
+            if (!perf_counter_is_valid(&counter))
+            {
+                std::cerr << "Error: Failed to open performance counter for event '" << name << "'.\n";
+            }
+            return counter;
+        };
+
+        auto cycle_counter = open_counter(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            return;
+        }
+
+        auto l1i_miss_counter = open_counter(L1I_MISS_EVENT, cycle_counter.fd);
+        auto itlb_miss_counter = open_counter(ITLB_MISS_EVENT, cycle_counter.fd);
+
+        if (!perf_counter_is_valid(&l1i_miss_counter) || !perf_counter_is_valid(&itlb_miss_counter))
+        {
+            const auto close_counter = [](perf_counter* const counter) {
+                if (perf_counter_is_valid(counter))
+                {
+                    perf_counter_close(counter);
+                }
+            };
+
+            close_counter(&l1i_miss_counter);
+            close_counter(&itlb_miss_counter);
+            close_counter(&cycle_counter);
+
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_l1i_misses = perf_counter_read(&l1i_miss_counter);
+            const auto start_itlb_misses = perf_counter_read(&itlb_miss_counter);
+            const auto start_cycles = perf_counter_read(&cycle_counter);
+
+            code.function(num_iterations);
+
+            const auto end_cycles = perf_counter_read(&cycle_counter);
+            const auto end_itlb_misses = perf_counter_read(&itlb_miss_counter);
+            const auto end_l1i_misses = perf_counter_read(&l1i_miss_counter);
+
+            const auto cycles = end_cycles - start_cycles;
+            if (i >= NUM_WARMUPS && cycles < result.cycle_count)
+            {
+                result.cycle_count = cycles;
+                result.l1i_miss_count = end_l1i_misses - start_l1i_misses;
+                result.itlb_miss_count = end_itlb_misses - start_itlb_misses;
+            }
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&itlb_miss_counter);
+        perf_counter_close(&l1i_miss_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+}  // namespace code_footprint
+
+int main()
+{
+    code_footprint::print_csv_header();
+
+    try
+    {
+        for (const auto layout : {code_footprint::Layout::StraightLine, code_footprint::Layout::JumpPerPage})
+        {
+            for (auto size = 4 * common::KiB; size <= 64 * common::MiB; size *= 2)  // NOLINT(readability-magic-numbers)
+            {
+                code_footprint::run_benchmark(layout, size, false);
+                code_footprint::run_benchmark(layout, size, true);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
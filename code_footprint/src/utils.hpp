@@ -0,0 +1,122 @@
+#pragma once
+
+#include "jit.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace code_footprint
+{
+    enum class Layout
+    {
+        // Back-to-back instructions filling the whole footprint; stresses the uop cache, L1I and L2
+        StraightLine,
+        // One cache line of instructions per 4 KiB page, ending in a jump to the next page; stresses the iTLB while
+        // touching few cache lines
+        JumpPerPage,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Layout layout) noexcept
+    {
+        switch (layout)
+        {
+            case Layout::StraightLine:
+                return "StraightLine";
+            case Layout::JumpPerPage:
+                return "JumpPerPage";
+        }
+        return "Unknown";
+    }
+
+    // Generated code takes the number of passes over the footprint
+    using CodeFunction = void (*)(std::uint64_t num_iterations);
+
+    constexpr auto CODE_LINE_SIZE = std::size_t{64};
+    constexpr auto CODE_PAGE_SIZE = std::size_t{4096};
+
+    // nopl 0(%rax): a 4-byte NOP that takes one decode slot and one uop
+    constexpr auto NOP_SIZE = std::size_t{4};
+
+    // Fills a line of each page except for the 5-byte jump at its end
+    constexpr auto NOPS_PER_PAGE_BLOCK = std::size_t{14};
+
+    struct GeneratedCode
+    {
+        CodeFunction function;
+        // Instructions executed per pass, including the loop-closing dec and jnz
+        std::size_t instructions_per_iteration;
+    };
+
+    namespace detail
+    {
+        constexpr auto INT3 = std::uint8_t{0xCC};
+
+        inline void emit_nop(common::JitBuffer& buffer) { buffer.emit({0x0F, 0x1F, 0x40, 0x00}); }
+
+        // dec %rdi; jnz <loop_offset>; ret
+        inline void emit_loop_tail(common::JitBuffer& buffer, const std::size_t loop_offset)
+        {
+            buffer.emit({0x48, 0xFF, 0xCF});
+            buffer.emit({0x0F, 0x85});
+            buffer.emit_rel32(loop_offset);
+            buffer.emit({0xC3});
+        }
+    }  // namespace detail
+
+    // Emits a loop whose body spans `footprint_bytes` of code in the given layout and makes the buffer executable
+    [[nodiscard]] inline GeneratedCode generate_code(common::JitBuffer& buffer, const Layout layout,
+                                                     const std::size_t footprint_bytes)
+    {
+        if (footprint_bytes == 0 || footprint_bytes % CODE_PAGE_SIZE != 0)
+        {
+            throw std::invalid_argument("`footprint_bytes` must be a non-zero multiple of " +
+                                        std::to_string(CODE_PAGE_SIZE) + ".");
+        }
+
+        const auto start = buffer.size();
+        auto num_instructions = std::size_t{2};
+
+        if (layout == Layout::StraightLine)
+        {
+            const auto num_nops = footprint_bytes / NOP_SIZE;
+            for (std::size_t i = 0; i < num_nops; ++i)
+            {
+                detail::emit_nop(buffer);
+            }
+            num_instructions += num_nops;
+        }
+        else
+        {
+            // The block moves one line further into each page so that the blocks do not all land in the same L1I set
+            const auto num_pages = footprint_bytes / CODE_PAGE_SIZE;
+            const auto lines_per_page = CODE_PAGE_SIZE / CODE_LINE_SIZE;
+            const auto block_offset = [&](const std::size_t page) {
+                return start + (page * CODE_PAGE_SIZE) + ((page % lines_per_page) * CODE_LINE_SIZE);
+            };
+            const auto tail = start + footprint_bytes;
+
+            for (std::size_t page = 0; page < num_pages; ++page)
+            {
+                buffer.pad_to(block_offset(page), detail::INT3);
+                for (std::size_t i = 0; i < NOPS_PER_PAGE_BLOCK; ++i)
+                {
+                    detail::emit_nop(buffer);
+                }
+
+                // jmp <next block>
+                buffer.emit({0xE9});
+                buffer.emit_rel32(page + 1 < num_pages ? block_offset(page + 1) : tail);
+            }
+            buffer.pad_to(tail, detail::INT3);
+            num_instructions += num_pages * (NOPS_PER_PAGE_BLOCK + 1);
+        }
+
+        detail::emit_loop_tail(buffer, start);
+        buffer.finalize();
+
+        return {buffer.get_function<CodeFunction>(start), num_instructions};
+    }
+
+}  // namespace code_footprint
@@ -0,0 +1,247 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace coherence_latency
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    constexpr auto HELPER_RELATIONS =
+        std::array<common::CpuRelation, 4>{common::CpuRelation::SmtSibling, common::CpuRelation::SharedL3,
+                                           common::CpuRelation::SamePackage, common::CpuRelation::RemotePackage};
+
+    // `helper_cpus` prepare the coherence state before the observer (the calling thread) walks the chain
+    struct Scenario
+    {
+        CoherenceState state;
+        common::CpuRelation relation;
+        std::vector<std::int32_t> helper_cpus;
+    };
+
+    struct BenchmarkResult
+    {
+        const common::MemoryBackend backend;
+        const std::size_t chain_size;
+        const std::size_t padded_element_size;
+        const CoherenceState state;
+        const common::CpuRelation relation;
+        const std::size_t num_helpers;
+        const std::size_t num_loads;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,ChainSize,PaddedElementSize,State,HelperRelation,NumHelpers,NumLoads,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.backend) << "," << result.chain_size << "," << result.padded_element_size << ","
+                  << to_string(result.state) << "," << common::to_string(result.relation) << "," << result.num_helpers
+                  << "," << result.num_loads << "," << result.cycle_count << "\n";
+    }
+
+    [[nodiscard]] std::vector<Scenario> build_scenarios(const std::int32_t observer_cpu,
+                                                        const std::vector<std::int32_t>& cpus)
+    {
+        constexpr auto NUM_SHARED_READERS = std::size_t{2};
+
+        auto scenarios = std::vector<Scenario>{
+            {CoherenceState::Local, common::CpuRelation::Same, {}},
+            {CoherenceState::Invalid, common::CpuRelation::Same, {}},
+        };
+
+        const auto observer = common::get_cpu_location(observer_cpu);
+
+        for (const auto relation : HELPER_RELATIONS)
+        {
+            auto helper_cpus = std::vector<std::int32_t>();
+            for (const auto cpu : cpus)
+            {
+                if (common::get_cpu_relation(observer, common::get_cpu_location(cpu)) == relation)
+                {
+                    helper_cpus.push_back(cpu);
+                }
+            }
+
+            if (helper_cpus.empty())
+            {
+                continue;
+            }
+
+            scenarios.push_back({CoherenceState::Modified, relation, {helper_cpus[0]}});
+            scenarios.push_back({CoherenceState::Exclusive, relation, {helper_cpus[0]}});
+
+            // A single reader would leave the lines Exclusive
+            if (helper_cpus.size() >= NUM_SHARED_READERS)
+            {
+                helper_cpus.resize(NUM_SHARED_READERS);
+                scenarios.push_back({CoherenceState::Shared, relation, helper_cpus});
+            }
+        }
+
+        return scenarios;
+    }
+
+    template <typename Function>
+    void run_on_cpu(const std::int32_t cpu, Function&& function)
+    {
+        auto error = std::exception_ptr();
+        auto thread = std::thread([&]() {
+            try
+            {
+                common::pin_current_thread_to_cpu(cpu);
+                function();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        });
+        thread.join();
+
+        if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void prepare_state(const Scenario& scenario, MemoryAddress* const buffer, const std::size_t num_elements,
+                       const std::size_t padded_bytes_per_element)
+    {
+        switch (scenario.state)
+        {
+            case CoherenceState::Local:
+                read_elements(buffer, num_elements, padded_bytes_per_element);
+                break;
+            case CoherenceState::Invalid:
+                flush_elements(buffer, num_elements, padded_bytes_per_element);
+                break;
+            case CoherenceState::Modified:
+                run_on_cpu(scenario.helper_cpus[0],
+                           [&]() { write_elements(buffer, num_elements, padded_bytes_per_element); });
+                break;
+            case CoherenceState::Exclusive:
+            case CoherenceState::Shared:
+                flush_elements(buffer, num_elements, padded_bytes_per_element);
+                for (const auto cpu : scenario.helper_cpus)
+                {
+                    run_on_cpu(cpu, [&]() { read_elements(buffer, num_elements, padded_bytes_per_element); });
+                }
+                break;
+        }
+    }
+
+    void run_benchmark(const common::MemoryBackend backend, const std::size_t num_elements,
+                       const std::size_t padded_bytes_per_element, const std::vector<Scenario>& scenarios)
+    {
+        constexpr auto STEPS_PER_WALK = std::int32_t{1000};
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+        constexpr auto RAND_SEED = std::uint64_t{12345};
+
+        // Every element is visited exactly once per measurement, because the first visit changes its state
+        if (num_elements % STEPS_PER_WALK != 0)
+        {
+            std::cerr << "Error: `num_elements` must be a multiple of " << STEPS_PER_WALK << "\n";
+            return;
+        }
+        const auto num_walks = num_elements / STEPS_PER_WALK;
+        const auto buffer_size_in_bytes = num_elements * padded_bytes_per_element;
+
+        const auto buffer = common::MemoryBuffer(buffer_size_in_bytes, backend);
+        auto* const elements = buffer.data<MemoryAddress>();
+
+        auto* const start_ptr =
+            common::generate_random_pointer_chasing(elements, num_elements, padded_bytes_per_element, RAND_SEED);
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        auto* volatile kernel = common::walk_pointer_chain<STEPS_PER_WALK>;
+
+        for (const auto& scenario : scenarios)
+        {
+            auto result = BenchmarkResult{backend, buffer_size_in_bytes, padded_bytes_per_element, scenario.state,
+                                          scenario.relation, scenario.helper_cpus.size(), num_elements};
+
+            for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+            {
+                prepare_state(scenario, elements, num_elements, padded_bytes_per_element);
+
+                const auto start_cycles = perf_counter_read(&cycle_counter);
+
+                auto* current_ptr = start_ptr;
+                for (std::size_t w = 0; w < num_walks; ++w)
+                {
+                    current_ptr = kernel(current_ptr);
+                }
+
+                const auto end_cycles = perf_counter_read(&cycle_counter);
+
+                const auto latency_cycles = end_cycles - start_cycles;
+
+                if (i >= NUM_WARMUPS && latency_cycles < result.cycle_count)
+                {
+                    result.cycle_count = latency_cycles;
+                }
+            }
+
+            print_csv_row(result);
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+    }
+
+}  // namespace coherence_latency
+
+int main()
+{
+    coherence_latency::print_csv_header();
+
+    try
+    {
+        const auto cpus = common::get_available_cpus();
+        const auto observer_cpu = cpus.front();
+        common::pin_current_thread_to_cpu(observer_cpu);
+
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+        const auto scenarios = coherence_latency::build_scenarios(observer_cpu, cpus);
+
+        // From L1/L2-resident chains up to chains that spill into the L3
+        constexpr auto MIN_ELEMENTS = std::size_t{1000};
+        constexpr auto MAX_ELEMENTS = std::size_t{64'000};
+        for (const auto backend : common::get_memory_backends({common::MemoryBackend::Thp}))
+        {
+            for (auto num_elements = MIN_ELEMENTS; num_elements <= MAX_ELEMENTS; num_elements *= 2)
+            {
+                coherence_latency::run_benchmark(backend, num_elements, cache_line_bytes, scenarios);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "pointer_chasing.hpp"
+
+#include <immintrin.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace coherence_latency
+{
+    using common::MemoryAddress;
+
+    enum class CoherenceState
+    {
+        Local,
+        Invalid,
+        Modified,
+        Exclusive,
+        Shared,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const CoherenceState state) noexcept
+    {
+        switch (state)
+        {
+            case CoherenceState::Local:
+                return "Local";
+            case CoherenceState::Invalid:
+                return "Invalid";
+            case CoherenceState::Modified:
+                return "Modified";
+            case CoherenceState::Exclusive:
+                return "Exclusive";
+            case CoherenceState::Shared:
+                return "Shared";
+        }
+        return "Unknown";
+    }
+
+    // Evicts every element from all cache levels of all cores
+    inline void flush_elements(MemoryAddress* const buffer, const std::size_t num_elements,
+                               const std::size_t padded_bytes_per_element)
+    {
+        auto* const bytes = reinterpret_cast<unsigned char*>(buffer);
+        for (std::size_t i = 0; i < num_elements; ++i)
+        {
+            _mm_clflush(bytes + (i * padded_bytes_per_element));
+        }
+        _mm_mfence();
+    }
+
+    // Pulls every element into the calling core's caches; a single reader leaves the lines Exclusive, several readers
+    // leave them Shared.
+    inline void read_elements(MemoryAddress* const buffer, const std::size_t num_elements,
+                              const std::size_t padded_bytes_per_element)
+    {
+        auto* const bytes = reinterpret_cast<unsigned char*>(buffer);
+        for (std::size_t i = 0; i < num_elements; ++i)
+        {
+            auto* const element_ptr = reinterpret_cast<MemoryAddress*>(bytes + (i * padded_bytes_per_element));
+            static_cast<void>(*static_cast<MemoryAddress volatile*>(element_ptr));
+        }
+        _mm_mfence();
+    }
+
+    // Rewrites every element with its own value, which leaves the lines Modified in the calling core's caches
+    inline void write_elements(MemoryAddress* const buffer, const std::size_t num_elements,
+                               const std::size_t padded_bytes_per_element)
+    {
+        auto* const bytes = reinterpret_cast<unsigned char*>(buffer);
+        for (std::size_t i = 0; i < num_elements; ++i)
+        {
+            auto* const element_ptr = static_cast<MemoryAddress volatile*>(
+                reinterpret_cast<MemoryAddress*>(bytes + (i * padded_bytes_per_element)));
+            *element_ptr = *element_ptr;
+        }
+        _mm_mfence();
+    }
+
+}  // namespace coherence_latency
@@ -0,0 +1,176 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace coroutine_pointer_chasing
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    struct KernelInfo
+    {
+        const char* name;
+        LookupKernel kernel;
+        bool is_grouped;
+    };
+
+    constexpr auto KERNELS = std::array<KernelInfo, 4>{{
+        {"Scalar", chase_scalar, false},
+        {"GroupPrefetch", chase_group_prefetch, true},
+        {"AMAC", chase_amac, true},
+        {"Coroutine", chase_coroutine, true},
+    }};
+
+    constexpr auto GROUP_SIZES = std::array<std::size_t, 6>{1, 2, 4, 8, 16, 32};
+
+    struct BenchmarkResult
+    {
+        const common::MemoryBackend backend;
+        const std::size_t buffer_size;
+        const std::size_t padded_element_size;
+        const char* const kernel_name;
+        const std::size_t group_size;
+        const std::size_t num_lookups;
+        const std::int32_t steps_per_lookup;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,BufferSize,PaddedElementSize,Kernel,GroupSize,NumLookups,StepsPerLookup,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.backend) << "," << result.buffer_size << "," << result.padded_element_size << ","
+                  << result.kernel_name << "," << result.group_size << "," << result.num_lookups << ","
+                  << result.steps_per_lookup << "," << result.cycle_count << "\n";
+    }
+
+    void run_benchmark(const common::MemoryBackend backend, const std::size_t buffer_size_in_bytes,
+                       const std::size_t padded_bytes_per_element)
+    {
+        constexpr auto NUM_LOOKUPS = std::size_t{1} << 16U;
+        constexpr auto STEPS_PER_LOOKUP = std::int32_t{16};
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+        constexpr auto RAND_SEED = std::uint64_t{12345};
+
+        if (buffer_size_in_bytes % padded_bytes_per_element != 0)
+        {
+            std::cerr << "Error: `buffer_size_in_bytes` must be a multiple of `padded_bytes_per_element`\n";
+            return;
+        }
+        const auto num_elements = buffer_size_in_bytes / padded_bytes_per_element;
+
+        const auto buffer = common::MemoryBuffer(buffer_size_in_bytes, backend);
+
+        static_cast<void>(common::generate_random_pointer_chasing(buffer.data<MemoryAddress>(), num_elements,
+                                                                  padded_bytes_per_element, RAND_SEED));
+
+        // Every element belongs to the same cycle, so any element is a valid, independent entry point.
+        auto start_ptrs = std::vector<MemoryAddress*>(NUM_LOOKUPS);
+        auto rng = std::mt19937_64(RAND_SEED + 1);
+        auto dist = std::uniform_int_distribution<std::size_t>(0, num_elements - 1);
+        for (auto& start_ptr : start_ptrs)
+        {
+            auto* const element_ptr = buffer.data<unsigned char>() + (dist(rng) * padded_bytes_per_element);
+            start_ptr = reinterpret_cast<MemoryAddress*>(element_ptr);
+        }
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        const auto expected_checksum = chase_scalar(start_ptrs, STEPS_PER_LOOKUP, 1);
+
+        for (const auto& kernel_info : KERNELS)
+        {
+            for (const auto group_size : GROUP_SIZES)
+            {
+                if (!kernel_info.is_grouped && group_size != 1)
+                {
+                    continue;
+                }
+
+                auto* volatile kernel = kernel_info.kernel;
+
+                auto result = BenchmarkResult{backend, buffer_size_in_bytes, padded_bytes_per_element, kernel_info.name,
+                                              group_size, NUM_LOOKUPS, STEPS_PER_LOOKUP};
+                auto is_valid = true;
+
+                for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+                {
+                    const auto start_cycles = perf_counter_read(&cycle_counter);
+
+                    const auto checksum = kernel(start_ptrs, STEPS_PER_LOOKUP, group_size);
+
+                    const auto end_cycles = perf_counter_read(&cycle_counter);
+
+                    if (checksum != expected_checksum)
+                    {
+                        std::cerr << "Error: Kernel '" << kernel_info.name << "' visited different nodes than the "
+                                  << "scalar chase.\n";
+                        is_valid = false;
+                        break;
+                    }
+
+                    const auto latency_cycles = end_cycles - start_cycles;
+
+                    if (i >= NUM_WARMUPS && latency_cycles < result.cycle_count)
+                    {
+                        result.cycle_count = latency_cycles;
+                    }
+                }
+
+                if (is_valid)
+                {
+                    print_csv_row(result);
+                }
+            }
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+    }
+
+}  // namespace coroutine_pointer_chasing
+
+int main()
+{
+    coroutine_pointer_chasing::print_csv_header();
+
+    try
+    {
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+
+        for (const auto backend : common::get_memory_backends({common::MemoryBackend::Thp}))
+        {
+            for (auto size = 16 * common::KiB; size <= 1 * common::GiB; size *= 2)  // NOLINT(readability-magic-numbers)
+            {
+                coroutine_pointer_chasing::run_benchmark(backend, size, cache_line_bytes);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "pointer_chasing.hpp"
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace coroutine_pointer_chasing
+{
+    using common::MemoryAddress;
+
+    using LookupKernel = std::uintptr_t (*)(const std::vector<MemoryAddress*>&, std::int32_t, std::size_t);
+
+    namespace detail
+    {
+        [[nodiscard]] inline MemoryAddress* load_next(MemoryAddress* const current_ptr) noexcept
+        {
+            return static_cast<MemoryAddress*>(*current_ptr);
+        }
+
+        // Recycles coroutine frames so that the measured loop does not include heap allocation.
+        class FramePool
+        {
+        public:
+            FramePool() = default;
+            FramePool(const FramePool&) = delete;
+            FramePool& operator=(const FramePool&) = delete;
+            FramePool(FramePool&&) = delete;
+            FramePool& operator=(FramePool&&) = delete;
+
+            ~FramePool()
+            {
+                while (free_frames_ != nullptr)
+                {
+                    auto* const next = free_frames_->next;
+                    ::operator delete(static_cast<void*>(free_frames_));
+                    free_frames_ = next;
+                }
+            }
+
+            [[nodiscard]] static void* allocate(const std::size_t size)
+            {
+                auto& pool = instance();
+                if (size == pool.frame_size_ && pool.free_frames_ != nullptr)
+                {
+                    auto* const frame = pool.free_frames_;
+                    pool.free_frames_ = frame->next;
+                    return static_cast<void*>(frame);
+                }
+                return ::operator new(size);
+            }
+
+            static void deallocate(void* const ptr, const std::size_t size) noexcept
+            {
+                auto& pool = instance();
+                if (pool.frame_size_ == 0 && size >= sizeof(FreeFrame))
+                {
+                    pool.frame_size_ = size;
+                }
+
+                if (size != pool.frame_size_)
+                {
+                    ::operator delete(ptr);
+                    return;
+                }
+
+                auto* const frame = ::new (ptr) FreeFrame{pool.free_frames_};
+                pool.free_frames_ = frame;
+            }
+
+        private:
+            struct FreeFrame
+            {
+                FreeFrame* next;
+            };
+
+            [[nodiscard]] static FramePool& instance()
+            {
+                thread_local FramePool pool;
+                return pool;
+            }
+
+            FreeFrame* free_frames_ = nullptr;
+            std::size_t frame_size_ = 0;
+        };
+
+        class LookupTask
+        {
+        public:
+            struct promise_type
+            {
+                MemoryAddress* result = nullptr;
+
+                [[nodiscard]] LookupTask get_return_object() noexcept
+                {
+                    return LookupTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+                [[nodiscard]] std::suspend_always initial_suspend() const noexcept { return {}; }
+                [[nodiscard]] std::suspend_always final_suspend() const noexcept { return {}; }
+                void return_value(MemoryAddress* const ptr) noexcept { result = ptr; }
+                [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+
+                [[nodiscard]] static void* operator new(const std::size_t size) { return FramePool::allocate(size); }
+                static void operator delete(void* const ptr, const std::size_t size) noexcept
+                {
+                    FramePool::deallocate(ptr, size);
+                }
+            };
+
+            LookupTask() noexcept = default;
+            explicit LookupTask(const std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+            LookupTask(const LookupTask&) = delete;
+            LookupTask& operator=(const LookupTask&) = delete;
+
+            LookupTask(LookupTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+            LookupTask& operator=(LookupTask&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    reset();
+                    handle_ = std::exchange(other.handle_, nullptr);
+                }
+                return *this;
+            }
+
+            ~LookupTask() { reset(); }
+
+            [[nodiscard]] bool is_active() const noexcept { return static_cast<bool>(handle_); }
+            [[nodiscard]] bool is_done() const noexcept { return handle_.done(); }
+            [[nodiscard]] MemoryAddress* get_result() const noexcept { return handle_.promise().result; }
+            void resume() const { handle_.resume(); }
+
+            void reset() noexcept
+            {
+                if (handle_)
+                {
+                    handle_.destroy();
+                    handle_ = nullptr;
+                }
+            }
+
+        private:
+            std::coroutine_handle<promise_type> handle_ = nullptr;
+        };
+
+        // One lookup: prefetch the next node, yield to the scheduler, and dereference it once resumed.
+        inline LookupTask chase_lookup(MemoryAddress* current_ptr, const std::int32_t steps_per_lookup)
+        {
+            for (std::int32_t i = 0; i < steps_per_lookup; ++i)
+            {
+                __builtin_prefetch(current_ptr);
+                co_await std::suspend_always{};
+                current_ptr = load_next(current_ptr);
+            }
+            co_return current_ptr;
+        }
+    }  // namespace detail
+
+    // Runs lookups one by one; every load depends on the previous one.
+    inline std::uintptr_t chase_scalar(const std::vector<MemoryAddress*>& start_ptrs,
+                                       const std::int32_t steps_per_lookup, const std::size_t /*group_size*/)
+    {
+        auto checksum = std::uintptr_t{0};
+        for (auto* const start_ptr : start_ptrs)
+        {
+            auto* current_ptr = start_ptr;
+            for (std::int32_t i = 0; i < steps_per_lookup; ++i)
+            {
+                current_ptr = detail::load_next(current_ptr);
+            }
+            checksum += reinterpret_cast<std::uintptr_t>(current_ptr);
+        }
+        return checksum;
+    }
+
+    // Group prefetching: advances `group_size` lookups in lock step, prefetching all nodes of a stage first.
+    inline std::uintptr_t chase_group_prefetch(const std::vector<MemoryAddress*>& start_ptrs,
+                                               const std::int32_t steps_per_lookup, const std::size_t group_size)
+    {
+        auto checksum = std::uintptr_t{0};
+        auto current_ptrs = std::vector<MemoryAddress*>(group_size);
+
+        for (std::size_t base = 0; base < start_ptrs.size(); base += group_size)
+        {
+            const auto count = std::min(group_size, start_ptrs.size() - base);
+            std::copy_n(start_ptrs.begin() + static_cast<std::ptrdiff_t>(base), count, current_ptrs.begin());
+
+            for (std::int32_t i = 0; i < steps_per_lookup; ++i)
+            {
+                for (std::size_t g = 0; g < count; ++g)
+                {
+                    __builtin_prefetch(current_ptrs[g]);
+                }
+                for (std::size_t g = 0; g < count; ++g)
+                {
+                    current_ptrs[g] = detail::load_next(current_ptrs[g]);
+                }
+            }
+
+            for (std::size_t g = 0; g < count; ++g)
+            {
+                checksum += reinterpret_cast<std::uintptr_t>(current_ptrs[g]);
+            }
+        }
+        return checksum;
+    }
+
+    // Asynchronous memory access chaining (AMAC): a ring of `group_size` lookup states where a finished lookup is
+    // immediately replaced by the next pending one.
+    inline std::uintptr_t chase_amac(const std::vector<MemoryAddress*>& start_ptrs, const std::int32_t steps_per_lookup,
+                                     const std::size_t group_size)
+    {
+        struct LookupState
+        {
+            MemoryAddress* current_ptr = nullptr;
+            std::int32_t remaining_steps = 0;
+        };
+
+        auto checksum = std::uintptr_t{0};
+        auto states = std::vector<LookupState>(group_size);
+        auto next_lookup = std::size_t{0};
+        auto num_active = std::size_t{0};
+
+        for (auto& state : states)
+        {
+            if (next_lookup == start_ptrs.size())
+            {
+                break;
+            }
+            state = LookupState{start_ptrs[next_lookup++], steps_per_lookup};
+            __builtin_prefetch(state.current_ptr);
+            ++num_active;
+        }
+
+        while (num_active > 0)
+        {
+            for (auto& state : states)
+            {
+                if (state.current_ptr == nullptr)
+                {
+                    continue;
+                }
+
+                state.current_ptr = detail::load_next(state.current_ptr);
+                if (--state.remaining_steps == 0)
+                {
+                    checksum += reinterpret_cast<std::uintptr_t>(state.current_ptr);
+                    if (next_lookup == start_ptrs.size())
+                    {
+                        state = LookupState{};
+                        --num_active;
+                        continue;
+                    }
+                    state = LookupState{start_ptrs[next_lookup++], steps_per_lookup};
+                }
+                __builtin_prefetch(state.current_ptr);
+            }
+        }
+        return checksum;
+    }
+
+    // Same schedule as AMAC, but each lookup is a stackless coroutine that suspends after issuing its prefetch.
+    inline std::uintptr_t chase_coroutine(const std::vector<MemoryAddress*>& start_ptrs,
+                                          const std::int32_t steps_per_lookup, const std::size_t group_size)
+    {
+        auto checksum = std::uintptr_t{0};
+        auto tasks = std::vector<detail::LookupTask>(group_size);
+        auto next_lookup = std::size_t{0};
+        auto num_active = std::size_t{0};
+
+        for (auto& task : tasks)
+        {
+            if (next_lookup == start_ptrs.size())
+            {
+                break;
+            }
+            task = detail::chase_lookup(start_ptrs[next_lookup++], steps_per_lookup);
+            task.resume();
+            ++num_active;
+        }
+
+        while (num_active > 0)
+        {
+            for (auto& task : tasks)
+            {
+                if (!task.is_active())
+                {
+                    continue;
+                }
+
+                task.resume();
+                if (task.is_done())
+                {
+                    checksum += reinterpret_cast<std::uintptr_t>(task.get_result());
+                    if (next_lookup == start_ptrs.size())
+                    {
+                        task.reset();
+                        --num_active;
+                        continue;
+                    }
+                    task = detail::chase_lookup(start_ptrs[next_lookup++], steps_per_lookup);
+                    task.resume();
+                }
+            }
+        }
+        return checksum;
+    }
+
+}  // namespace coroutine_pointer_chasing
@@ -0,0 +1,262 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace false_sharing
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+#ifdef __znver2__
+    constexpr auto HITM_EVENT =
+        "amd64_fam17h_zen2::DATA_CACHE_REFILLS_FROM_SYSTEM"
+        ":LS_MABRESP_LCL_CACHE"
+        ":LS_MABRESP_RMT_CACHE";
+#else
+    constexpr auto HITM_EVENT = "MEM_LOAD_L3_HIT_RETIRED:XSNP_HITM";
+#endif
+
+#ifdef __cpp_lib_hardware_interference_size
+    constexpr auto INTERFERENCE_SIZE = std::hardware_destructive_interference_size;
+#else
+    constexpr auto INTERFERENCE_SIZE = std::size_t{0};
+#endif
+
+    constexpr auto INCREMENT_MODES = std::array<IncrementMode, 2>{IncrementMode::Plain, IncrementMode::Atomic};
+
+    struct BenchmarkResult
+    {
+        const std::size_t distance;
+        const std::size_t cache_line_size;
+        const std::size_t num_threads;
+        const IncrementMode mode;
+        const std::size_t increments_per_thread;
+        const bool counts_hitm;
+        std::int64_t elapsed_ns = std::numeric_limits<std::int64_t>::max();
+        std::uint64_t hitm_count = 0;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Distance,CacheLineSize,InterferenceSize,Threads,Mode,IncrementsPerThread,Nanoseconds,"
+                     "HitmEvents\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << result.distance << "," << result.cache_line_size << "," << INTERFERENCE_SIZE << ","
+                  << result.num_threads << "," << to_string(result.mode) << "," << result.increments_per_thread
+                  << "," << result.elapsed_ns << ",";
+        if (result.counts_hitm)
+        {
+            std::cout << result.hitm_count;
+        }
+        else
+        {
+            std::cout << "NA";
+        }
+        std::cout << "\n";
+    }
+
+    // Whether HITM events can be counted on this CPU; the event name is model-specific
+    [[nodiscard]] bool can_count_hitm()
+    {
+        auto hitm_counter = perf_counter_open_by_name(HITM_EVENT, -1);
+        if (!perf_counter_is_valid(&hitm_counter))
+        {
+            return false;
+        }
+        perf_counter_close(&hitm_counter);
+        return true;
+    }
+
+    // Counters of one worker thread, opened by the thread itself before the measurement starts and closed by whoever
+    // destroys them once all workers have finished
+    class ThreadCounters
+    {
+    public:
+        ThreadCounters() = default;
+
+        ~ThreadCounters()
+        {
+            if (hitm_)
+            {
+                perf_counter_close(&*hitm_);
+            }
+            if (cycles_)
+            {
+                perf_counter_disable(&*cycles_);
+                perf_counter_close(&*cycles_);
+            }
+        }
+
+        ThreadCounters(const ThreadCounters&) = delete;
+        ThreadCounters& operator=(const ThreadCounters&) = delete;
+        ThreadCounters(ThreadCounters&&) = delete;
+        ThreadCounters& operator=(ThreadCounters&&) = delete;
+
+        // The cycle counter only leads the group, so that the HITM counter, if any, is scheduled with it
+        void open(const bool count_hitm)
+        {
+            auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+            if (!perf_counter_is_valid(&cycle_counter))
+            {
+                throw std::runtime_error(std::string("Failed to open performance counter for event '") +
+                                         CYCLES_EVENT + "'.");
+            }
+            cycles_ = cycle_counter;
+
+            if (count_hitm)
+            {
+                auto hitm_counter = perf_counter_open_by_name(HITM_EVENT, cycle_counter.fd);
+                if (!perf_counter_is_valid(&hitm_counter))
+                {
+                    throw std::runtime_error(std::string("Failed to open performance counter for event '") +
+                                             HITM_EVENT + "'.");
+                }
+                hitm_ = hitm_counter;
+            }
+
+            perf_counter_enable(&*cycles_);
+        }
+
+        [[nodiscard]] std::uint64_t read_hitm() { return hitm_ ? perf_counter_read(&*hitm_) : 0; }
+
+    private:
+        std::optional<perf_counter> cycles_;
+        std::optional<perf_counter> hitm_;
+    };
+
+    // Increments the counter and returns the number of HITM events observed by the calling thread
+    template <IncrementMode MODE>
+    std::uint64_t run_counting_thread(std::uint64_t* const counter, const std::size_t num_increments,
+                                      ThreadCounters& counters)
+    {
+        const auto start_hitm = counters.read_hitm();
+        increment_counter<MODE>(counter, num_increments);
+        const auto end_hitm = counters.read_hitm();
+
+        return end_hitm - start_hitm;
+    }
+
+    void run_benchmark(const std::size_t distance, const std::size_t cache_line_bytes,
+                       const std::vector<std::vector<std::int32_t>>& thread_cpu_sets, const bool count_hitm)
+    {
+        constexpr auto INCREMENTS_PER_THREAD = std::size_t{10'000'000};
+        constexpr auto NUM_TRIALS = std::int32_t{5};
+        constexpr auto NUM_WARMUPS = std::int32_t{1};
+
+        if (distance % sizeof(std::uint64_t) != 0)
+        {
+            std::cerr << "Error: `distance` must be a multiple of " << sizeof(std::uint64_t) << "\n";
+            return;
+        }
+
+        const auto page_size = common::get_page_size();
+        const auto max_threads = thread_cpu_sets.empty() ? std::size_t{0} : thread_cpu_sets.back().size();
+        const auto buffer_size_in_bytes = std::max(max_threads * distance, sizeof(std::uint64_t));
+
+        auto buffer = common::allocate_aligned_buffer<unsigned char>(buffer_size_in_bytes, page_size);
+        std::memset(buffer.get(), 0, buffer_size_in_bytes);
+
+        const auto get_counter = [&](const std::size_t thread_index) {
+            return reinterpret_cast<std::uint64_t*>(buffer.get() + (thread_index * distance));
+        };
+
+        for (const auto mode : INCREMENT_MODES)
+        {
+            const auto thread_function = mode == IncrementMode::Plain ? run_counting_thread<IncrementMode::Plain>
+                                                                      : run_counting_thread<IncrementMode::Atomic>;
+
+            for (const auto& cpus : thread_cpu_sets)
+            {
+                auto result = BenchmarkResult{distance, cache_line_bytes, cpus.size(), mode, INCREMENTS_PER_THREAD,
+                                              count_hitm};
+
+                for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+                {
+                    auto hitm_counts = std::vector<std::uint64_t>(cpus.size());
+                    auto counters = std::vector<ThreadCounters>(cpus.size());
+                    const auto elapsed_ns = common::run_pinned_threads(
+                        cpus, [&](const std::size_t thread_index) { counters[thread_index].open(count_hitm); },
+                        [&](const std::size_t thread_index) {
+                            hitm_counts[thread_index] = thread_function(get_counter(thread_index),
+                                                                        INCREMENTS_PER_THREAD, counters[thread_index]);
+                        });
+
+                    if (i >= NUM_WARMUPS && elapsed_ns < result.elapsed_ns)
+                    {
+                        result.elapsed_ns = elapsed_ns;
+                        result.hitm_count = 0;
+                        for (const auto count : hitm_counts)
+                        {
+                            result.hitm_count += count;
+                        }
+                    }
+                }
+
+                print_csv_row(result);
+            }
+        }
+    }
+
+}  // namespace false_sharing
+
+int main()
+{
+    false_sharing::print_csv_header();
+
+    try
+    {
+        const auto cpus = common::get_available_cpus();
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+        const auto page_size = common::get_page_size();
+
+        auto thread_cpu_sets = std::vector<std::vector<std::int32_t>>();
+        for (std::size_t num_threads = 2; num_threads < cpus.size(); num_threads *= 2)
+        {
+            thread_cpu_sets.emplace_back(cpus.begin(), cpus.begin() + static_cast<std::ptrdiff_t>(num_threads));
+        }
+        thread_cpu_sets.push_back(cpus);
+
+        // Same line, adjacent lines, line pairs (adjacent-line prefetcher) and separate pages
+        auto distances = std::vector<std::size_t>{sizeof(std::uint64_t), cache_line_bytes, 2 * cache_line_bytes,
+                                                  page_size};
+        if (false_sharing::INTERFERENCE_SIZE != 0)
+        {
+            distances.push_back(false_sharing::INTERFERENCE_SIZE);
+        }
+        std::sort(distances.begin(), distances.end());
+        distances.erase(std::unique(distances.begin(), distances.end()), distances.end());
+
+        const auto count_hitm = false_sharing::can_count_hitm();
+        if (!count_hitm)
+        {
+            std::cerr << "Warning: Event '" << false_sharing::HITM_EVENT << "' is not available; HitmEvents is NA.\n";
+        }
+
+        for (const auto distance : distances)
+        {
+            false_sharing::run_benchmark(distance, cache_line_bytes, thread_cpu_sets, count_hitm);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace false_sharing
+{
+    enum class IncrementMode
+    {
+        Plain,
+        Atomic,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const IncrementMode mode) noexcept
+    {
+        switch (mode)
+        {
+            case IncrementMode::Plain:
+                return "Plain";
+            case IncrementMode::Atomic:
+                return "Atomic";
+        }
+        return "Unknown";
+    }
+
+    // Plain increments are a volatile load and store, as in a per-thread statistics counter; atomic increments are
+    // `lock add`. Either way, every store needs the line in the Modified state.
+    template <IncrementMode MODE>
+    void increment_counter(std::uint64_t* const counter, const std::size_t num_increments)
+    {
+        for (std::size_t i = 0; i < num_increments; ++i)
+        {
+            if constexpr (MODE == IncrementMode::Plain)
+            {
+                auto* const volatile_counter = static_cast<volatile std::uint64_t*>(counter);
+                *volatile_counter = *volatile_counter + 1;
+            }
+            else
+            {
+                __atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+}  // namespace false_sharing
@@ -0,0 +1,154 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "utils.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+
+namespace fence_cost
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    using StepKernel = void (*)(unsigned char*, std::size_t, std::uint64_t*, const std::uint64_t*, std::int32_t);
+
+    struct KernelInfo
+    {
+        Access access;
+        Fence fence;
+        StepKernel kernel;
+    };
+
+    template <Access ACCESS, Fence... FENCES>
+    constexpr std::array<KernelInfo, sizeof...(FENCES)> make_kernel_infos()
+    {
+        return {{{ACCESS, FENCES, execute_steps<ACCESS, FENCES>}...}};
+    }
+
+    template <Access ACCESS>
+    constexpr auto KERNELS =
+        make_kernel_infos<ACCESS, Fence::None, Fence::MFence, Fence::SFence, Fence::LFence, Fence::LockAddRsp,
+                          Fence::ReleaseStore, Fence::SeqCstStoreXchg, Fence::SeqCstStoreMFence,
+                          Fence::ReleaseAcquirePair, Fence::SeqCstStoreLoadPair>();
+
+    struct BenchmarkResult
+    {
+        const common::MemoryBackend backend;
+        const std::size_t buffer_size;
+        const Access access;
+        const Fence fence;
+        const std::int32_t num_steps;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,BufferSize,Access,Fence,NumSteps,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.backend) << "," << result.buffer_size << "," << to_string(result.access) << ","
+                  << to_string(result.fence) << "," << result.num_steps << "," << result.cycle_count << "\n";
+    }
+
+    // `Access::None` steps never touch the buffer, so it may be null with a zero size
+    void run_benchmark(const KernelInfo& info, const common::MemoryBackend backend, unsigned char* const buffer,
+                       const std::size_t buffer_size_in_bytes, std::uint64_t* const flag,
+                       const std::uint64_t* const next_line)
+    {
+        constexpr auto NUM_STEPS = std::int32_t{100'000};
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        auto result = BenchmarkResult{backend, buffer_size_in_bytes, info.access, info.fence, NUM_STEPS};
+
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_cycles = perf_counter_read(&cycle_counter);
+
+            info.kernel(buffer, buffer_size_in_bytes - 1, flag, next_line, NUM_STEPS);
+
+            const auto end_cycles = perf_counter_read(&cycle_counter);
+
+            const auto cycles = end_cycles - start_cycles;
+            if (i >= NUM_WARMUPS && cycles < result.cycle_count)
+            {
+                result.cycle_count = cycles;
+            }
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+    template <Access ACCESS>
+    void run_benchmarks(const common::MemoryBackend backend, unsigned char* const buffer,
+                        const std::size_t buffer_size_in_bytes, std::uint64_t* const flag,
+                        const std::uint64_t* const next_line)
+    {
+        for (const auto& info : KERNELS<ACCESS>)
+        {
+            run_benchmark(info, backend, buffer, buffer_size_in_bytes, flag, next_line);
+        }
+    }
+
+}  // namespace fence_cost
+
+int main()
+{
+    constexpr auto MIN_BUFFER_SIZE = 16 * common::KiB;
+    constexpr auto MAX_BUFFER_SIZE = 512 * common::MiB;
+
+    fence_cost::print_csv_header();
+
+    try
+    {
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+
+        // The flag written by the store-based fences and the line loaded right after it
+        auto flag = common::allocate_aligned_buffer<std::uint64_t>(2 * cache_line_bytes, cache_line_bytes);
+        std::memset(flag.get(), 0, 2 * cache_line_bytes);
+        const auto* const next_line = flag.get() + (cache_line_bytes / sizeof(std::uint64_t));
+
+        for (const auto backend : common::get_memory_backends({common::MemoryBackend::Thp}))
+        {
+            // Fences on their own, repeated per backend to keep one baseline per group of rows
+            fence_cost::run_benchmarks<fence_cost::Access::None>(backend, nullptr, 0, flag.get(), next_line);
+
+            // Fences interleaved with loads and stores that hit in L1, L2, L3 and DRAM as the buffer grows
+            for (auto size = MIN_BUFFER_SIZE; size <= MAX_BUFFER_SIZE; size *= 8)  // NOLINT(readability-magic-numbers)
+            {
+                const auto buffer = common::MemoryBuffer(size, backend);
+                std::memset(buffer.data<unsigned char>(), 1, size);
+
+                fence_cost::run_benchmarks<fence_cost::Access::Load>(backend, buffer.data<unsigned char>(), size,
+                                                                     flag.get(), next_line);
+                fence_cost::run_benchmarks<fence_cost::Access::Store>(backend, buffer.data<unsigned char>(), size,
+                                                                      flag.get(), next_line);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#define REP10(x) x x x x x x x x x x
+#define REP100(x) REP10(REP10(x))
+
+namespace fence_cost
+{
+    // Memory access issued before the fence in every step
+    enum class Access
+    {
+        None,
+        Load,
+        Store,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Access access) noexcept
+    {
+        switch (access)
+        {
+            case Access::None:
+                return "None";
+            case Access::Load:
+                return "Load";
+            case Access::Store:
+                return "Store";
+        }
+        return "Unknown";
+    }
+
+    // Ordering instruction (sequence) issued after the access in every step. The store-based fences write to a flag
+    // line and the pairs then load from the next line, as in Dekker-style handshakes.
+    enum class Fence
+    {
+        None,
+        MFence,
+        SFence,
+        LFence,
+        LockAddRsp,
+        ReleaseStore,
+        SeqCstStoreXchg,
+        SeqCstStoreMFence,
+        ReleaseAcquirePair,
+        SeqCstStoreLoadPair,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Fence fence) noexcept
+    {
+        switch (fence)
+        {
+            case Fence::None:
+                return "None";
+            case Fence::MFence:
+                return "MFence";
+            case Fence::SFence:
+                return "SFence";
+            case Fence::LFence:
+                return "LFence";
+            case Fence::LockAddRsp:
+                return "LockAddRsp";
+            case Fence::ReleaseStore:
+                return "ReleaseStore";
+            case Fence::SeqCstStoreXchg:
+                return "SeqCstStoreXchg";
+            case Fence::SeqCstStoreMFence:
+                return "SeqCstStoreMFence";
+            case Fence::ReleaseAcquirePair:
+                return "ReleaseAcquirePair";
+            case Fence::SeqCstStoreLoadPair:
+                return "SeqCstStoreLoadPair";
+        }
+        return "Unknown";
+    }
+
+    constexpr auto UNROLL_COUNT = std::int32_t{100};
+
+    // An odd multiple of the cache line size, so that masking the offset by a power-of-2 buffer size visits every line
+    // before repeating, and large enough to cross a page on every access to defeat the stream prefetchers
+    constexpr auto ACCESS_STRIDE = std::size_t{65 * 64};
+
+    // Runs `num_steps` steps of (access at `buffer + offset`, advance offset, fence). `offset_mask` is the buffer size
+    // minus one. `flag` is the line written by the store-based fences and `next_line` the line the pairs load from.
+    template <Access ACCESS, Fence FENCE>
+    void execute_steps(unsigned char* buffer, std::size_t offset_mask, std::uint64_t* flag,
+                       const std::uint64_t* next_line, std::int32_t num_steps);
+
+#define FENCE_COST_DEFINE_STEPS(ACCESS, FENCE, ACCESS_ASM, FENCE_ASM)                                                  \
+    template <>                                                                                                        \
+    inline void execute_steps<Access::ACCESS, Fence::FENCE>(                                                           \
+        unsigned char* const buffer, const std::size_t offset_mask, std::uint64_t* const flag,                         \
+        const std::uint64_t* const next_line, const std::int32_t num_steps)                                            \
+    {                                                                                                                  \
+        auto offset = std::size_t{0};                                                                                  \
+        auto value = std::uint64_t{0};                                                                                 \
+        auto flag_value = std::uint64_t{0};                                                                            \
+        auto loaded_value = std::uint64_t{0};                                                                          \
+        for (std::int32_t i = 0; i < num_steps; i += UNROLL_COUNT)                                                     \
+        {                                                                                                              \
+            __asm__ volatile(REP100(ACCESS_ASM "add %[stride], %[offset]\n\t"                                          \
+                                               "and %[mask], %[offset]\n\t" FENCE_ASM)                                 \
+                             : [offset] "+r"(offset), [value] "+r"(value), [flag_value] "+r"(flag_value),              \
+                               [loaded_value] "+r"(loaded_value)                                                       \
+                             : [buffer] "r"(buffer), [mask] "r"(offset_mask), [stride] "i"(ACCESS_STRIDE),             \
+                               [flag] "r"(flag), [next_line] "r"(next_line)                                            \
+                             : "memory");                                                                              \
+        }                                                                                                              \
+    }
+
+#define FENCE_COST_DEFINE_FENCE(FENCE, FENCE_ASM)                                                                      \
+    FENCE_COST_DEFINE_STEPS(None, FENCE, "", FENCE_ASM)                                                                \
+    FENCE_COST_DEFINE_STEPS(Load, FENCE, "mov (%[buffer], %[offset]), %[value]\n\t", FENCE_ASM)                       \
+    FENCE_COST_DEFINE_STEPS(Store, FENCE, "mov %[value], (%[buffer], %[offset])\n\t", FENCE_ASM)
+
+    FENCE_COST_DEFINE_FENCE(None, "")
+    FENCE_COST_DEFINE_FENCE(MFence, "mfence\n\t")
+    FENCE_COST_DEFINE_FENCE(SFence, "sfence\n\t")
+    FENCE_COST_DEFINE_FENCE(LFence, "lfence\n\t")
+    FENCE_COST_DEFINE_FENCE(LockAddRsp, "lock addl $0, (%%rsp)\n\t")
+    FENCE_COST_DEFINE_FENCE(ReleaseStore, "mov %[flag_value], (%[flag])\n\t")
+    FENCE_COST_DEFINE_FENCE(SeqCstStoreXchg, "xchg %[flag_value], (%[flag])\n\t")
+    FENCE_COST_DEFINE_FENCE(SeqCstStoreMFence, "mov %[flag_value], (%[flag])\n\tmfence\n\t")
+    FENCE_COST_DEFINE_FENCE(ReleaseAcquirePair,
+                            "mov %[flag_value], (%[flag])\n\tmov (%[next_line]), %[loaded_value]\n\t")
+    FENCE_COST_DEFINE_FENCE(SeqCstStoreLoadPair,
+                            "xchg %[flag_value], (%[flag])\n\tmov (%[next_line]), %[loaded_value]\n\t")
+
+#undef FENCE_COST_DEFINE_FENCE
+#undef FENCE_COST_DEFINE_STEPS
+
+}  // namespace fence_cost
+
+#undef REP100
+#undef REP10
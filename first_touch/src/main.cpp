@@ -0,0 +1,137 @@
+#include "common.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace first_touch
+{
+    constexpr auto BUFFER_SIZE = 256 * common::MiB;
+
+    struct BenchmarkResult
+    {
+        const Backing backing;
+        const Preparation preparation;
+        const std::size_t num_threads;
+        const std::size_t buffer_size;
+        const std::size_t page_size;
+        std::int64_t prepare_ns = std::numeric_limits<std::int64_t>::max();
+        std::int64_t touch_ns = std::numeric_limits<std::int64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Backing,Preparation,NumThreads,BufferSize,PageSize,NumPages,PrepareNanoseconds,"
+                     "TouchNanoseconds\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.backing) << "," << to_string(result.preparation) << "," << result.num_threads
+                  << "," << result.buffer_size << "," << result.page_size << ","
+                  << result.buffer_size / result.page_size << "," << result.prepare_ns << "," << result.touch_ns
+                  << "\n";
+    }
+
+    // Maps and prepares a fresh buffer on the calling thread, then has every CPU of `cpus` write to each base page of
+    // its own slice of it. Faults of one mapping from many threads contend on the mm's locks.
+    void run_benchmark(const Backing backing, const Preparation preparation, const std::vector<std::int32_t>& cpus)
+    {
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+
+        const auto base_page_size = common::get_page_size();
+
+        auto result = BenchmarkResult{backing, preparation, cpus.size(), BUFFER_SIZE, get_page_size(backing)};
+        auto min_total_ns = std::numeric_limits<std::int64_t>::max();
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_time = std::chrono::steady_clock::now();
+            const auto mapping = Mapping(BUFFER_SIZE, backing, preparation);
+            const auto end_time = std::chrono::steady_clock::now();
+
+            // Whole pages per thread, so that no page is faulted by two threads
+            const auto num_pages = mapping.size() / mapping.page_size();
+            const auto touch_ns = common::run_pinned_threads(cpus, [&](const std::size_t t) {
+                auto* const begin = mapping.data() + ((t * num_pages / cpus.size()) * mapping.page_size());
+                auto* const end = mapping.data() + (((t + 1) * num_pages / cpus.size()) * mapping.page_size());
+                touch(begin, end, base_page_size);
+            });
+
+            const auto prepare_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+            if (i >= NUM_WARMUPS && prepare_ns + touch_ns < min_total_ns)
+            {
+                min_total_ns = prepare_ns + touch_ns;
+                result.prepare_ns = prepare_ns;
+                result.touch_ns = touch_ns;
+            }
+        }
+
+        print_csv_row(result);
+    }
+
+}  // namespace first_touch
+
+int main()
+{
+    using first_touch::Backing;
+    using first_touch::Preparation;
+
+    first_touch::print_csv_header();
+
+    try
+    {
+        const auto cpus = common::get_available_cpus();
+
+        // Powers of 2 up to every available CPU
+        auto thread_counts = std::vector<std::size_t>();
+        for (std::size_t n = 1; n < cpus.size(); n *= 2)
+        {
+            thread_counts.push_back(n);
+        }
+        thread_counts.push_back(cpus.size());
+
+        for (const auto backing : {Backing::Regular, Backing::Thp, Backing::Hugetlbfs})
+        {
+            try
+            {
+                const auto probe = first_touch::Mapping(first_touch::BUFFER_SIZE, backing, Preparation::None);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Warning: Skipping " << first_touch::to_string(backing) << ": " << e.what() << "\n";
+                continue;
+            }
+
+            for (const auto preparation :
+                 {Preparation::None, Preparation::Populate, Preparation::WillNeed, Preparation::PreZero})
+            {
+                if (!first_touch::is_supported(backing, preparation))
+                {
+                    std::cerr << "Warning: Skipping " << first_touch::to_string(backing) << " with "
+                              << first_touch::to_string(preparation) << ": MADV_POPULATE_WRITE is not available.\n";
+                    continue;
+                }
+
+                for (const auto num_threads : thread_counts)
+                {
+                    const auto last = cpus.begin() + static_cast<std::ptrdiff_t>(num_threads);
+                    first_touch::run_benchmark(backing, preparation, std::vector<std::int32_t>(cpus.begin(), last));
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
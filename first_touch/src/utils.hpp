@@ -0,0 +1,171 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace first_touch
+{
+    enum class Backing
+    {
+        // Base pages, with THP disabled for the range
+        Regular,
+        // Anonymous memory advised with MADV_HUGEPAGE; faults allocate and zero a whole hugepage
+        Thp,
+        // MAP_HUGETLB pages from the reserved pool (/proc/sys/vm/nr_hugepages)
+        Hugetlbfs,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Backing backing) noexcept
+    {
+        switch (backing)
+        {
+            case Backing::Regular:
+                return "Regular";
+            case Backing::Thp:
+                return "Thp";
+            case Backing::Hugetlbfs:
+                return "Hugetlbfs";
+        }
+        return "Unknown";
+    }
+
+    // What is done between mapping the buffer and touching it; its cost counts as preparation
+    enum class Preparation
+    {
+        None,
+        // MAP_POPULATE; for THP, MADV_POPULATE_WRITE after the advice, since MAP_POPULATE would fault base pages
+        // before the range could be advised
+        Populate,
+        // madvise(MADV_WILLNEED)
+        WillNeed,
+        // memset of the whole buffer, as an allocator that hands out zeroed memory would do
+        PreZero,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Preparation preparation) noexcept
+    {
+        switch (preparation)
+        {
+            case Preparation::None:
+                return "None";
+            case Preparation::Populate:
+                return "Populate";
+            case Preparation::WillNeed:
+                return "WillNeed";
+            case Preparation::PreZero:
+                return "PreZero";
+        }
+        return "Unknown";
+    }
+
+    // Without MADV_POPULATE_WRITE, THP could only be populated by MAP_POPULATE, which faults base pages in before the
+    // range is advised, so that combination would not measure THP
+    [[nodiscard]] constexpr bool is_supported(const Backing backing, const Preparation preparation) noexcept
+    {
+#ifdef MADV_POPULATE_WRITE
+        static_cast<void>(backing);
+        static_cast<void>(preparation);
+        return true;
+#else
+        return backing != Backing::Thp || preparation != Preparation::Populate;
+#endif
+    }
+
+    [[nodiscard]] inline std::size_t get_page_size(const Backing backing)
+    {
+        return backing == Backing::Regular ? common::get_page_size() : common::get_hugepage_size();
+    }
+
+    // Anonymous mapping of the given backing, prepared as requested and unmapped on destruction
+    class Mapping
+    {
+    public:
+        Mapping(const std::size_t size_in_bytes, const Backing backing, const Preparation preparation)
+            : mapping_(size_in_bytes, get_page_size(backing), get_map_flags(backing, preparation))
+        {
+            prepare(backing, preparation);
+        }
+
+        [[nodiscard]] unsigned char* data() const noexcept { return mapping_.data(); }
+        [[nodiscard]] std::size_t size() const noexcept { return mapping_.size(); }
+        [[nodiscard]] std::size_t page_size() const noexcept { return mapping_.page_size(); }
+
+    private:
+        // Also rejects the unsupported combinations, before anything is mapped
+        [[nodiscard]] static int get_map_flags(const Backing backing, const Preparation preparation)
+        {
+            if (!is_supported(backing, preparation))
+            {
+                throw std::invalid_argument(std::string(to_string(preparation)) + " is not supported for " +
+                                            to_string(backing) + " memory.");
+            }
+
+            auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+            if (backing == Backing::Hugetlbfs)
+            {
+                flags |= MAP_HUGETLB;
+            }
+            if (preparation == Preparation::Populate && backing != Backing::Thp)
+            {
+                flags |= MAP_POPULATE;
+            }
+            return flags;
+        }
+
+        void prepare(const Backing backing, const Preparation preparation)
+        {
+            auto* const data = mapping_.data();
+            const auto size = mapping_.size();
+
+            if (backing != Backing::Hugetlbfs)
+            {
+                common::advise_hugepage(data, size, backing == Backing::Thp);
+            }
+
+            switch (preparation)
+            {
+                case Preparation::None:
+                    break;
+                case Preparation::Populate:
+#ifdef MADV_POPULATE_WRITE
+                    if (backing == Backing::Thp && madvise(data, size, MADV_POPULATE_WRITE) != 0)
+                    {
+                        throw std::runtime_error("madvise(MADV_POPULATE_WRITE) failed: " +
+                                                 std::string(std::strerror(errno)));
+                    }
+#endif
+                    break;
+                case Preparation::WillNeed:
+                    if (madvise(data, size, MADV_WILLNEED) != 0)
+                    {
+                        throw std::runtime_error("madvise(MADV_WILLNEED) failed: " +
+                                                 std::string(std::strerror(errno)));
+                    }
+                    break;
+                case Preparation::PreZero:
+                    std::memset(data, 0, size);
+                    break;
+            }
+        }
+
+        // Unmapped as a member, so also when `prepare` throws
+        common::PageMapping mapping_;
+    };
+
+    // Writes one byte of every `stride` bytes in [begin, end); writes, unlike reads, cannot be served by the zero page
+    inline void touch(unsigned char* const begin, unsigned char* const end, const std::size_t stride)
+    {
+        for (auto* byte = begin; byte < end; byte += stride)
+        {
+            *reinterpret_cast<volatile unsigned char*>(byte) = 1;
+        }
+    }
+
+}  // namespace first_touch
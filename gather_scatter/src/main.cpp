@@ -0,0 +1,216 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "utils.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace gather_scatter
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    constexpr auto DISTRIBUTIONS = std::array<Distribution, 4>{Distribution::Sequential, Distribution::Strided,
+                                                               Distribution::Random, Distribution::Clustered};
+
+    struct GatherKernelInfo
+    {
+        const char* name;
+        GatherKernel kernel;
+    };
+
+    struct ScatterKernelInfo
+    {
+        const char* name;
+        ScatterKernel kernel;
+    };
+
+    const auto GATHER_KERNELS = std::vector<GatherKernelInfo>{
+        {"Scalar", gather_scalar},
+#ifdef __AVX2__
+        {"AVX2", gather_avx2},
+#endif
+#if defined(__AVX512F__) && defined(__AVX512CD__) && defined(__AVX512VL__)
+        {"AVX512", gather_avx512},
+#endif
+    };
+
+    const auto SCATTER_KERNELS = std::vector<ScatterKernelInfo>{
+        {"Scalar", scatter_add_scalar},
+#if defined(__AVX512F__) && defined(__AVX512CD__) && defined(__AVX512VL__)
+        {"AVX512", scatter_add_avx512},
+#endif
+    };
+
+    struct BenchmarkResult
+    {
+        const common::MemoryBackend backend;
+        const std::size_t data_size;
+        const Distribution distribution;
+        const char* const operation;
+        const char* const kernel_name;
+        const std::size_t num_indices;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,DataSize,Distribution,Operation,Kernel,NumElements,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.backend) << "," << result.data_size << "," << to_string(result.distribution)
+                  << "," << result.operation << "," << result.kernel_name << "," << result.num_indices << ","
+                  << result.cycle_count << "\n";
+    }
+
+    void run_benchmark(const common::MemoryBackend backend, const std::size_t data_size_in_bytes,
+                       const Distribution distribution)
+    {
+        constexpr auto NUM_INDICES = std::size_t{1} << 20U;
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+        constexpr auto RAND_SEED = std::uint64_t{12345};
+        constexpr auto ADDEND = std::uint64_t{1};
+
+        const auto num_elements = data_size_in_bytes / sizeof(std::uint64_t);
+
+        const auto data_buffer = common::MemoryBuffer(data_size_in_bytes, backend);
+        auto* const data = data_buffer.data<std::uint64_t>();
+        const auto out_buffer = common::MemoryBuffer(NUM_INDICES * sizeof(std::uint64_t), backend);
+        auto* const out = out_buffer.data<std::uint64_t>();
+        auto expected_out = std::vector<std::uint64_t>(NUM_INDICES);
+
+        for (std::size_t i = 0; i < num_elements; ++i)
+        {
+            data[i] = i;
+        }
+
+        const auto indices = generate_indices(distribution, NUM_INDICES, num_elements, RAND_SEED);
+        gather_scalar(data, indices.data(), expected_out.data(), NUM_INDICES);
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        for (const auto& kernel_info : GATHER_KERNELS)
+        {
+            auto* volatile kernel = kernel_info.kernel;
+
+            auto result =
+                BenchmarkResult{backend, data_size_in_bytes, distribution, "Gather", kernel_info.name, NUM_INDICES};
+
+            for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+            {
+                const auto start_cycles = perf_counter_read(&cycle_counter);
+
+                kernel(data, indices.data(), out, NUM_INDICES);
+
+                const auto end_cycles = perf_counter_read(&cycle_counter);
+
+                const auto latency_cycles = end_cycles - start_cycles;
+
+                if (i >= NUM_WARMUPS && latency_cycles < result.cycle_count)
+                {
+                    result.cycle_count = latency_cycles;
+                }
+            }
+
+            if (std::memcmp(out, expected_out.data(), NUM_INDICES * sizeof(std::uint64_t)) != 0)
+            {
+                std::cerr << "Error: Gather kernel '" << kernel_info.name << "' produced a wrong result.\n";
+                continue;
+            }
+
+            print_csv_row(result);
+        }
+
+        for (const auto& kernel_info : SCATTER_KERNELS)
+        {
+            auto* volatile kernel = kernel_info.kernel;
+
+            auto result =
+                BenchmarkResult{backend, data_size_in_bytes, distribution, "ScatterAdd", kernel_info.name, NUM_INDICES};
+
+            for (std::size_t i = 0; i < num_elements; ++i)
+            {
+                data[i] = i;
+            }
+
+            for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+            {
+                const auto start_cycles = perf_counter_read(&cycle_counter);
+
+                kernel(data, indices.data(), ADDEND, NUM_INDICES);
+
+                const auto end_cycles = perf_counter_read(&cycle_counter);
+
+                const auto latency_cycles = end_cycles - start_cycles;
+
+                if (i >= NUM_WARMUPS && latency_cycles < result.cycle_count)
+                {
+                    result.cycle_count = latency_cycles;
+                }
+            }
+
+            // Subtract every run's additions with the scalar reference; a correct kernel leaves data[i] == i.
+            scatter_add_scalar(data, indices.data(), std::uint64_t{0} - ADDEND * (NUM_WARMUPS + NUM_TRIALS),
+                               NUM_INDICES);
+
+            auto is_valid = true;
+            for (std::size_t i = 0; i < num_elements; ++i)
+            {
+                is_valid = is_valid && data[i] == i;
+            }
+
+            if (!is_valid)
+            {
+                std::cerr << "Error: Scatter kernel '" << kernel_info.name << "' produced a wrong result.\n";
+                continue;
+            }
+
+            print_csv_row(result);
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+    }
+
+}  // namespace gather_scatter
+
+int main()
+{
+    gather_scatter::print_csv_header();
+
+    try
+    {
+        for (const auto backend : common::get_memory_backends({common::MemoryBackend::Thp}))
+        {
+            for (auto size = 16 * common::KiB; size <= 1 * common::GiB; size *= 2)  // NOLINT(readability-magic-numbers)
+            {
+                for (const auto distribution : gather_scatter::DISTRIBUTIONS)
+                {
+                    gather_scatter::run_benchmark(backend, size, distribution);
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <immintrin.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace gather_scatter
+{
+    using GatherKernel = void (*)(const std::uint64_t*, const std::uint32_t*, std::uint64_t*, std::size_t);
+    using ScatterKernel = void (*)(std::uint64_t*, const std::uint32_t*, std::uint64_t, std::size_t);
+
+    enum class Distribution
+    {
+        Sequential,
+        Strided,
+        Random,
+        Clustered,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Distribution distribution) noexcept
+    {
+        switch (distribution)
+        {
+            case Distribution::Sequential:
+                return "Sequential";
+            case Distribution::Strided:
+                return "Strided";
+            case Distribution::Random:
+                return "Random";
+            case Distribution::Clustered:
+                return "Clustered";
+        }
+        return "Unknown";
+    }
+
+    // Strided indices step by one cache line and shift by one element on every wrap-around, so the whole array is
+    // eventually covered. Clustered indices are short sequential runs starting at random positions.
+    [[nodiscard]] inline std::vector<std::uint32_t> generate_indices(const Distribution distribution,
+                                                                     const std::size_t num_indices,
+                                                                     const std::size_t num_elements,
+                                                                     const std::uint64_t seed)
+    {
+        constexpr auto STRIDE_ELEMENTS = std::size_t{8};
+        constexpr auto CLUSTER_ELEMENTS = std::size_t{8};
+
+        if (num_elements == 0 || num_elements > (std::size_t{1} << 31U))
+        {
+            throw std::invalid_argument("`num_elements` must be in [1, 2^31].");
+        }
+
+        auto indices = std::vector<std::uint32_t>(num_indices);
+        auto rng = std::mt19937_64(seed);
+        auto dist = std::uniform_int_distribution<std::size_t>(0, num_elements - 1);
+
+        for (std::size_t i = 0; i < num_indices; ++i)
+        {
+            auto index = std::size_t{0};
+            switch (distribution)
+            {
+                case Distribution::Sequential:
+                    index = i % num_elements;
+                    break;
+                case Distribution::Strided:
+                    index = ((i * STRIDE_ELEMENTS) + ((i * STRIDE_ELEMENTS) / num_elements)) % num_elements;
+                    break;
+                case Distribution::Random:
+                    index = dist(rng);
+                    break;
+                case Distribution::Clustered:
+                    index = (i % CLUSTER_ELEMENTS == 0) ? dist(rng) : (indices[i - 1] + 1) % num_elements;
+                    break;
+            }
+            indices[i] = static_cast<std::uint32_t>(index);
+        }
+
+        return indices;
+    }
+
+    inline void gather_scalar(const std::uint64_t* const data, const std::uint32_t* const indices,
+                              std::uint64_t* const out, const std::size_t num_indices)
+    {
+        for (std::size_t i = 0; i < num_indices; ++i)
+        {
+            auto index = indices[i];
+            // Hide the index from the optimizer so that the loop is not auto-vectorized into gathers
+            __asm__("" : "+r"(index));
+            out[i] = data[index];
+        }
+    }
+
+    inline void scatter_add_scalar(std::uint64_t* const data, const std::uint32_t* const indices,
+                                   const std::uint64_t value, const std::size_t num_indices)
+    {
+        for (std::size_t i = 0; i < num_indices; ++i)
+        {
+            auto index = indices[i];
+            __asm__("" : "+r"(index));
+            data[index] += value;
+        }
+    }
+
+#ifdef __AVX2__
+    // vpgatherdq: four 64-bit elements per instruction with 32-bit indices
+    inline void gather_avx2(const std::uint64_t* const data, const std::uint32_t* const indices,
+                            std::uint64_t* const out, const std::size_t num_indices)
+    {
+        constexpr auto LANES = std::size_t{4};
+        const auto* const base = reinterpret_cast<const long long*>(data);
+
+        std::size_t i = 0;
+        for (; i + LANES <= num_indices; i += LANES)
+        {
+            const auto vindex = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+            const auto values = _mm256_i32gather_epi64(base, vindex, sizeof(std::uint64_t));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+        }
+        gather_scalar(data, indices + i, out + i, num_indices - i);
+    }
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512CD__) && defined(__AVX512VL__)
+    namespace detail
+    {
+        // The masked form with a zeroed source avoids GCC's -Wmaybe-uninitialized on the unmasked intrinsic
+        [[nodiscard]] inline __m512i gather_epi64(const __m256i vindex, const std::uint64_t* const data)
+        {
+            constexpr auto ALL_LANES = static_cast<__mmask8>(0xFF);
+            return _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), ALL_LANES, vindex, data,
+                                               sizeof(std::uint64_t));
+        }
+    }  // namespace detail
+
+    inline void gather_avx512(const std::uint64_t* const data, const std::uint32_t* const indices,
+                              std::uint64_t* const out, const std::size_t num_indices)
+    {
+        constexpr auto LANES = std::size_t{8};
+
+        std::size_t i = 0;
+        for (; i + LANES <= num_indices; i += LANES)
+        {
+            const auto vindex = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+            const auto values = detail::gather_epi64(vindex, data);
+            _mm512_storeu_si512(out + i, values);
+        }
+        gather_scalar(data, indices + i, out + i, num_indices - i);
+    }
+
+    // Gather, add and scatter; vectors with duplicate indices (detected with vpconflictd) fall back to scalar code
+    // so that no increment is lost.
+    inline void scatter_add_avx512(std::uint64_t* const data, const std::uint32_t* const indices,
+                                   const std::uint64_t value, const std::size_t num_indices)
+    {
+        constexpr auto LANES = std::size_t{8};
+        const auto vvalue = _mm512_set1_epi64(static_cast<long long>(value));
+
+        std::size_t i = 0;
+        for (; i + LANES <= num_indices; i += LANES)
+        {
+            const auto vindex = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+            const auto conflicts = _mm256_conflict_epi32(vindex);
+            if (_mm256_test_epi32_mask(conflicts, conflicts) != 0)
+            {
+                scatter_add_scalar(data, indices + i, value, LANES);
+                continue;
+            }
+
+            const auto values = detail::gather_epi64(vindex, data);
+            _mm512_i32scatter_epi64(data, vindex, _mm512_add_epi64(values, vvalue), sizeof(std::uint64_t));
+        }
+        scatter_add_scalar(data, indices + i, value, num_indices - i);
+    }
+#endif
+
+}  // namespace gather_scatter
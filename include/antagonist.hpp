@@ -0,0 +1,305 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+    // Runs `function(thread_index, stop)` on one thread pinned to each of `cpus` from construction until destruction,
+    // which sets `stop` and joins. Construction returns once every thread is pinned and about to call `function`.
+    class BackgroundThreads
+    {
+    public:
+        template <typename Function>
+        BackgroundThreads(const std::vector<std::int32_t>& cpus, Function&& function)
+        {
+            auto num_started = std::atomic<std::size_t>{0};
+            auto errors = std::vector<std::exception_ptr>(cpus.size());
+
+            // The threads refer to `num_started` and `errors`, so they must be joined before a failure unwinds
+            try
+            {
+                threads_.reserve(cpus.size());
+                for (std::size_t t = 0; t < cpus.size(); ++t)
+                {
+                    threads_.emplace_back([&, t, cpu = cpus[t], function]() {
+                        try
+                        {
+                            pin_current_thread_to_cpu(cpu);
+                        }
+                        catch (...)
+                        {
+                            errors[t] = std::current_exception();
+                            num_started.fetch_add(1, std::memory_order_release);
+                            return;
+                        }
+
+                        num_started.fetch_add(1, std::memory_order_release);
+                        function(t, stop_);
+                    });
+                }
+            }
+            catch (...)
+            {
+                stop();
+                throw;
+            }
+
+            while (num_started.load(std::memory_order_acquire) != cpus.size())
+            {
+            }
+
+            for (const auto& error : errors)
+            {
+                if (error != nullptr)
+                {
+                    stop();
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        BackgroundThreads(const BackgroundThreads&) = delete;
+        BackgroundThreads& operator=(const BackgroundThreads&) = delete;
+        BackgroundThreads(BackgroundThreads&&) = delete;
+        BackgroundThreads& operator=(BackgroundThreads&&) = delete;
+
+        ~BackgroundThreads() { stop(); }
+
+    private:
+        void stop() noexcept
+        {
+            stop_.store(true, std::memory_order_relaxed);
+            for (auto& thread : threads_)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        std::atomic<bool> stop_{false};
+        std::vector<std::thread> threads_;
+    };
+
+    enum class ThrashLevel
+    {
+        None,
+        L2,
+        L3,
+        Dram,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const ThrashLevel level) noexcept
+    {
+        switch (level)
+        {
+            case ThrashLevel::None:
+                return "None";
+            case ThrashLevel::L2:
+                return "L2";
+            case ThrashLevel::L3:
+                return "L3";
+            case ThrashLevel::Dram:
+                return "Dram";
+        }
+        return "Unknown";
+    }
+
+    // A co-located job that keeps rewriting a buffer sized to overflow `level`. It works for `intensity_percent` of
+    // every period and sleeps for the rest, on `num_threads` CPUs (0 for every eligible CPU). The L2 is private to a
+    // core, so L2 antagonists run on the SMT siblings of the benchmark CPU and also contend for its ports, which
+    // `smt_interference` measures in isolation. L3 and DRAM antagonists stay off the benchmark core.
+    struct AntagonistProfile
+    {
+        ThrashLevel level = ThrashLevel::None;
+        std::int32_t intensity_percent = 100;
+        std::int32_t num_threads = 0;
+    };
+
+    // "None", or "<L2|L3|Dram>[:<intensity percent>[:<num threads>]]", e.g. "L3:50:4"
+    [[nodiscard]] inline AntagonistProfile parse_antagonist_profile(const std::string& spec)
+    {
+        const auto first_colon = spec.find(':');
+        const auto level_name = spec.substr(0, first_colon);
+
+        auto profile = AntagonistProfile{};
+        for (const auto level : {ThrashLevel::None, ThrashLevel::L2, ThrashLevel::L3, ThrashLevel::Dram})
+        {
+            if (level_name == to_string(level))
+            {
+                profile.level = level;
+                break;
+            }
+        }
+        if (level_name != to_string(profile.level))
+        {
+            throw std::invalid_argument("Unknown antagonist level '" + level_name + "'.");
+        }
+
+        if (first_colon != std::string::npos)
+        {
+            const auto second_colon = spec.find(':', first_colon + 1);
+            profile.intensity_percent = std::stoi(spec.substr(first_colon + 1, second_colon - first_colon - 1));
+            if (second_colon != std::string::npos)
+            {
+                profile.num_threads = std::stoi(spec.substr(second_colon + 1));
+            }
+        }
+
+        if (profile.intensity_percent < 0 || profile.intensity_percent > 100)
+        {
+            throw std::invalid_argument("The antagonist intensity must be in [0, 100].");
+        }
+        if (profile.num_threads < 0)
+        {
+            throw std::invalid_argument("The antagonist thread count must not be negative.");
+        }
+        return profile;
+    }
+
+    // Canonical form of the profile for CSV columns
+    [[nodiscard]] inline std::string to_string(const AntagonistProfile& profile)
+    {
+        if (profile.level == ThrashLevel::None)
+        {
+            return to_string(profile.level);
+        }
+        return std::string(to_string(profile.level)) + ":" + std::to_string(profile.intensity_percent) + ":" +
+               std::to_string(profile.num_threads);
+    }
+
+    namespace detail
+    {
+        constexpr auto THRASH_PERIOD = std::chrono::microseconds(1000);
+        constexpr auto MIN_DRAM_THRASH_BYTES = 256 * MiB;
+
+        // Bytes each thread rewrites: twice its private L2, or a share of twice the L3 (four times for DRAM)
+        [[nodiscard]] inline std::size_t get_thrash_buffer_size(const ThrashLevel level, const std::size_t num_threads)
+        {
+            const auto l2_size = static_cast<std::size_t>(std::max(sysconf(_SC_LEVEL2_CACHE_SIZE), 1L));
+            const auto l3_size = static_cast<std::size_t>(std::max(sysconf(_SC_LEVEL3_CACHE_SIZE), 1L));
+            switch (level)
+            {
+                case ThrashLevel::None:
+                    return 0;
+                case ThrashLevel::L2:
+                    return 2 * l2_size;
+                case ThrashLevel::L3:
+                    return std::max(2 * l3_size / num_threads, 2 * l2_size);
+                case ThrashLevel::Dram:
+                    return std::max(4 * l3_size, MIN_DRAM_THRASH_BYTES) / num_threads;
+            }
+            return 0;
+        }
+
+        // Increments one word of every line, so that the lines become dirty and must be written back when evicted
+        inline void thrash(unsigned char* const buffer, const std::size_t buffer_size, const std::size_t line_size,
+                           const std::int32_t intensity_percent, const std::atomic<bool>& stop)
+        {
+            constexpr auto LINES_PER_CHECK = std::size_t{64};
+
+            auto offset = std::size_t{0};
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto period_start = std::chrono::steady_clock::now();
+                const auto active_end = period_start + (THRASH_PERIOD * intensity_percent / 100);
+                while (std::chrono::steady_clock::now() < active_end)
+                {
+                    for (std::size_t i = 0; i < LINES_PER_CHECK; ++i)
+                    {
+                        auto* const word = reinterpret_cast<volatile std::uint64_t*>(buffer + offset);
+                        *word = *word + 1;
+                        offset = offset + line_size < buffer_size ? offset + line_size : 0;
+                    }
+                }
+
+                if (intensity_percent < 100)
+                {
+                    std::this_thread::sleep_until(period_start + THRASH_PERIOD);
+                }
+            }
+        }
+    }  // namespace detail
+
+    // Runs the profile next to `benchmark_cpu` for as long as the object lives
+    class NoisyNeighbors
+    {
+    public:
+        NoisyNeighbors(const AntagonistProfile& profile, const std::int32_t benchmark_cpu)
+        {
+            if (profile.level == ThrashLevel::None || profile.intensity_percent == 0)
+            {
+                return;
+            }
+
+            const auto benchmark_location = get_cpu_location(benchmark_cpu);
+            const auto is_ineligible = [&](const std::int32_t cpu) {
+                const auto relation = get_cpu_relation(benchmark_location, get_cpu_location(cpu));
+                if (profile.level == ThrashLevel::L2)
+                {
+                    return relation != CpuRelation::SmtSibling;
+                }
+                return relation == CpuRelation::Same || relation == CpuRelation::SmtSibling;
+            };
+
+            auto cpus = get_available_cpus();
+            cpus.erase(std::remove_if(cpus.begin(), cpus.end(), is_ineligible), cpus.end());
+            if (profile.num_threads > 0)
+            {
+                if (static_cast<std::size_t>(profile.num_threads) > cpus.size())
+                {
+                    throw std::invalid_argument("Only " + std::to_string(cpus.size()) +
+                                                " CPUs are available for antagonists.");
+                }
+                cpus.resize(static_cast<std::size_t>(profile.num_threads));
+            }
+            if (cpus.empty())
+            {
+                throw std::runtime_error(profile.level == ThrashLevel::L2
+                                             ? "L2 antagonists need an available SMT sibling of the benchmark CPU."
+                                             : "No CPU is left for antagonists.");
+            }
+
+            const auto line_size = get_cache_line_bytes();
+            const auto buffer_size = detail::get_thrash_buffer_size(profile.level, cpus.size());
+            for (std::size_t i = 0; i < cpus.size(); ++i)
+            {
+                buffers_.push_back(allocate_aligned_buffer<unsigned char>(buffer_size, get_page_size()));
+                std::memset(buffers_.back().get(), 0, buffer_size);
+            }
+
+            threads_ = std::make_unique<BackgroundThreads>(
+                cpus, [this, buffer_size, line_size, profile](const std::size_t t, const std::atomic<bool>& stop) {
+                    detail::thrash(buffers_[t].get(), buffer_size, line_size, profile.intensity_percent, stop);
+                });
+        }
+
+        NoisyNeighbors(const NoisyNeighbors&) = delete;
+        NoisyNeighbors& operator=(const NoisyNeighbors&) = delete;
+        NoisyNeighbors(NoisyNeighbors&&) = delete;
+        NoisyNeighbors& operator=(NoisyNeighbors&&) = delete;
+        ~NoisyNeighbors() = default;
+
+    private:
+        std::vector<std::unique_ptr<unsigned char, void (*)(void*)>> buffers_;
+        // Declared last so that the threads stop before their buffers are freed
+        std::unique_ptr<BackgroundThreads> threads_;
+    };
+
+}  // namespace common
@@ -1,13 +1,30 @@
 #pragma once
 
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <iostream>
 #include <memory>
 #include <new>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace common
 {
@@ -99,4 +116,588 @@ namespace common
 
         return {static_cast<T*>(buffer), std::free};
     }
+
+    inline void advise_hugepage(void* const buffer, const std::size_t buffer_size_in_bytes, const bool use_hugepage)
+    {
+        const auto advice = use_hugepage ? MADV_HUGEPAGE : MADV_NOHUGEPAGE;
+        if (madvise(buffer, buffer_size_in_bytes, advice) != 0)
+        {
+            std::cerr << "Warning: madvise(" << (use_hugepage ? "MADV_HUGEPAGE" : "MADV_NOHUGEPAGE")
+                      << ") failed: " << std::strerror(errno) << "\n";
+        }
+    }
+
+    [[nodiscard]] inline std::vector<std::int32_t> get_available_cpus()
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+        {
+            throw std::runtime_error("Failed to get the CPU affinity: " + std::string(std::strerror(errno)));
+        }
+
+        auto cpus = std::vector<std::int32_t>();
+        for (std::int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpu_set))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    inline void pin_current_thread_to_cpu(const std::int32_t cpu)
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+
+        const auto error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+        if (error != 0)
+        {
+            throw std::runtime_error("Failed to pin the thread to CPU " + std::to_string(cpu) + ": " +
+                                     std::strerror(error));
+        }
+    }
+
+    // Runs `function(thread_index)` on one thread pinned to each of `cpus`. Each thread first runs
+    // `setup(thread_index)`, e.g. to open its performance counters, outside the measured time. All threads are then
+    // released at once, and the wall-clock time until the last one finishes is returned in nanoseconds.
+    template <typename Setup, typename Function>
+    [[nodiscard]] std::int64_t run_pinned_threads(const std::vector<std::int32_t>& cpus, Setup&& setup,
+                                                  Function&& function)
+    {
+        auto num_ready = std::atomic<std::size_t>{0};
+        auto start_flag = std::atomic<bool>{false};
+        auto is_aborted = std::atomic<bool>{false};
+        auto errors = std::vector<std::exception_ptr>(cpus.size());
+
+        auto threads = std::vector<std::thread>();
+        try
+        {
+            threads.reserve(cpus.size());
+            for (std::size_t t = 0; t < cpus.size(); ++t)
+            {
+                threads.emplace_back([&, t]() {
+                    try
+                    {
+                        pin_current_thread_to_cpu(cpus[t]);
+                        setup(t);
+                    }
+                    catch (...)
+                    {
+                        errors[t] = std::current_exception();
+                    }
+
+                    num_ready.fetch_add(1, std::memory_order_release);
+                    while (!start_flag.load(std::memory_order_acquire))
+                    {
+                    }
+
+                    if (errors[t] != nullptr || is_aborted.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+
+                    try
+                    {
+                        function(t);
+                    }
+                    catch (...)
+                    {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            }
+        }
+        catch (...)
+        {
+            // Release the threads already started without running `function`, since they refer to these locals
+            is_aborted.store(true, std::memory_order_relaxed);
+            start_flag.store(true, std::memory_order_release);
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            throw;
+        }
+
+        while (num_ready.load(std::memory_order_acquire) != cpus.size())
+        {
+        }
+
+        const auto start_time = std::chrono::steady_clock::now();
+        start_flag.store(true, std::memory_order_release);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        const auto end_time = std::chrono::steady_clock::now();
+
+        for (const auto& error : errors)
+        {
+            if (error != nullptr)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+    }
+
+    template <typename Function>
+    [[nodiscard]] std::int64_t run_pinned_threads(const std::vector<std::int32_t>& cpus, Function&& function)
+    {
+        return run_pinned_threads(cpus, [](std::size_t) {}, std::forward<Function>(function));
+    }
+
+    enum class CpuRelation
+    {
+        Same,
+        SmtSibling,
+        SharedL3,
+        SamePackage,
+        RemotePackage,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const CpuRelation relation) noexcept
+    {
+        switch (relation)
+        {
+            case CpuRelation::Same:
+                return "Same";
+            case CpuRelation::SmtSibling:
+                return "SmtSibling";
+            case CpuRelation::SharedL3:
+                return "SharedL3";
+            case CpuRelation::SamePackage:
+                return "SamePackage";
+            case CpuRelation::RemotePackage:
+                return "RemotePackage";
+        }
+        return "Unknown";
+    }
+
+    struct CpuLocation
+    {
+        std::int32_t cpu;
+        std::int32_t package_id;
+        std::int32_t core_id;
+        std::int32_t l3_id;
+    };
+
+    [[nodiscard]] inline CpuLocation get_cpu_location(const std::int32_t cpu)
+    {
+        const auto read_id = [cpu](const std::string& name) {
+            std::ifstream ifs("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/" + name);
+            std::int32_t id = -1;
+            if (!(ifs >> id))
+            {
+                return std::int32_t{-1};
+            }
+            return id;
+        };
+
+        return CpuLocation{cpu, read_id("topology/physical_package_id"), read_id("topology/core_id"),
+                           read_id("cache/index3/id")};
+    }
+
+    [[nodiscard]] inline CpuRelation get_cpu_relation(const CpuLocation& lhs, const CpuLocation& rhs) noexcept
+    {
+        if (lhs.cpu == rhs.cpu)
+        {
+            return CpuRelation::Same;
+        }
+        if (lhs.package_id != rhs.package_id)
+        {
+            return CpuRelation::RemotePackage;
+        }
+        if (lhs.core_id == rhs.core_id)
+        {
+            return CpuRelation::SmtSibling;
+        }
+        if (lhs.l3_id == rhs.l3_id)
+        {
+            return CpuRelation::SharedL3;
+        }
+        return CpuRelation::SamePackage;
+    }
+
+    [[nodiscard]] inline std::int32_t get_numa_node_count()
+    {
+        std::int32_t num_nodes = 0;
+        while (std::ifstream("/sys/devices/system/node/node" + std::to_string(num_nodes) + "/cpulist").is_open())
+        {
+            ++num_nodes;
+        }
+        return num_nodes > 0 ? num_nodes : 1;
+    }
+
+    inline void bind_memory_to_numa_node(void* const buffer, const std::size_t buffer_size_in_bytes,
+                                         const std::int32_t node)
+    {
+        constexpr auto MAX_NODES = static_cast<std::int32_t>(sizeof(unsigned long) * 8);
+        if (node < 0 || node >= MAX_NODES)
+        {
+            throw std::invalid_argument("`node` must be in [0, " + std::to_string(MAX_NODES) + ").");
+        }
+
+        // mbind only reads `maxnode - 1` bits of the mask
+        const auto node_mask = 1UL << static_cast<unsigned>(node);
+        if (syscall(SYS_mbind, buffer, buffer_size_in_bytes, MPOL_BIND, &node_mask, MAX_NODES + 1, 0) != 0)
+        {
+            throw std::runtime_error("Failed to bind memory to NUMA node " + std::to_string(node) + ": " +
+                                     std::strerror(errno));
+        }
+    }
+
+    inline void interleave_memory_across_numa_nodes(void* const buffer, const std::size_t buffer_size_in_bytes)
+    {
+        constexpr auto MAX_NODES = static_cast<std::int32_t>(sizeof(unsigned long) * 8);
+        const auto num_nodes = get_numa_node_count();
+        const auto node_mask = num_nodes >= MAX_NODES ? ~0UL : (1UL << static_cast<unsigned>(num_nodes)) - 1;
+        if (syscall(SYS_mbind, buffer, buffer_size_in_bytes, MPOL_INTERLEAVE, &node_mask, MAX_NODES + 1, 0) != 0)
+        {
+            throw std::runtime_error("Failed to interleave memory across NUMA nodes: " +
+                                     std::string(std::strerror(errno)));
+        }
+    }
+
+    [[nodiscard]] inline std::int32_t get_current_numa_node()
+    {
+        auto cpu = 0U;
+        auto node = 0U;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+        {
+            throw std::runtime_error("Failed to get the current NUMA node: " + std::string(std::strerror(errno)));
+        }
+        return static_cast<std::int32_t>(node);
+    }
+
+    // Where a benchmark's buffer comes from. Every backend but `Locked` leaves the pages unfaulted.
+    enum class MemoryBackend
+    {
+        // Private anonymous mapping of base pages, with THP disabled
+        Anonymous,
+        // Private anonymous mapping advised with MADV_HUGEPAGE and aligned to the THP size
+        Thp,
+        // MAP_HUGETLB pages from the reserved pools of each size (/sys/kernel/mm/hugepages)
+        Hugetlb2M,
+        Hugetlb1G,
+        // Shared mapping of a memfd, i.e. tmpfs pages as used for file-backed shared memory
+        Memfd,
+        // `Anonymous`, mlock'd, which faults in every page up front
+        Locked,
+        // `Anonymous`, bound to the NUMA node the allocating thread runs on
+        NumaLocal,
+        // `Anonymous`, interleaved across every NUMA node
+        NumaInterleaved,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const MemoryBackend backend) noexcept
+    {
+        switch (backend)
+        {
+            case MemoryBackend::Anonymous:
+                return "Anonymous";
+            case MemoryBackend::Thp:
+                return "Thp";
+            case MemoryBackend::Hugetlb2M:
+                return "Hugetlb2M";
+            case MemoryBackend::Hugetlb1G:
+                return "Hugetlb1G";
+            case MemoryBackend::Memfd:
+                return "Memfd";
+            case MemoryBackend::Locked:
+                return "Locked";
+            case MemoryBackend::NumaLocal:
+                return "NumaLocal";
+            case MemoryBackend::NumaInterleaved:
+                return "NumaInterleaved";
+        }
+        return "Unknown";
+    }
+
+    [[nodiscard]] inline MemoryBackend parse_memory_backend(const std::string& name)
+    {
+        for (const auto backend :
+             {MemoryBackend::Anonymous, MemoryBackend::Thp, MemoryBackend::Hugetlb2M, MemoryBackend::Hugetlb1G,
+              MemoryBackend::Memfd, MemoryBackend::Locked, MemoryBackend::NumaLocal, MemoryBackend::NumaInterleaved})
+        {
+            if (name == to_string(backend))
+            {
+                return backend;
+            }
+        }
+        throw std::invalid_argument("Unknown memory backend '" + name + "'.");
+    }
+
+    // Backends named in the comma-separated MICRO_BENCHMARK_MEMORY_BACKENDS environment variable, e.g. "Thp,Memfd",
+    // or `defaults` when it is unset. Benchmarks sweep their buffers over these.
+    [[nodiscard]] inline std::vector<MemoryBackend> get_memory_backends(const std::vector<MemoryBackend>& defaults)
+    {
+        const auto* const names = std::getenv("MICRO_BENCHMARK_MEMORY_BACKENDS");
+        if (names == nullptr || *names == '\0')
+        {
+            return defaults;
+        }
+
+        auto backends = std::vector<MemoryBackend>();
+        auto stream = std::istringstream(names);
+        auto name = std::string();
+        while (std::getline(stream, name, ','))
+        {
+            backends.push_back(parse_memory_backend(name));
+        }
+        return backends;
+    }
+
+    [[nodiscard]] inline std::size_t get_page_size(const MemoryBackend backend)
+    {
+        switch (backend)
+        {
+            case MemoryBackend::Thp:
+                return get_hugepage_size();
+            case MemoryBackend::Hugetlb2M:
+                return 2 * MiB;
+            case MemoryBackend::Hugetlb1G:
+                return 1 * GiB;
+            default:
+                return get_page_size();
+        }
+    }
+
+    // Read-write mapping of `size_in_bytes` rounded up to whole `page_size` pages, starting on a page boundary and
+    // unmapped on destruction. The kernel aligns only MAP_HUGETLB mappings to their page size, so other mappings with
+    // pages above the base page size (THP) are over-allocated by one page and aligned here.
+    class PageMapping
+    {
+    public:
+        PageMapping(const std::size_t size_in_bytes, const std::size_t page_size, const int flags, const int fd = -1)
+            : page_size_(page_size)
+        {
+            size_ = (std::max(size_in_bytes, std::size_t{1}) + (page_size_ - 1)) & ~(page_size_ - 1);
+            const auto is_aligned_by_kernel = (flags & MAP_HUGETLB) != 0 || page_size_ <= get_page_size();
+            mapping_size_ = size_ + (is_aligned_by_kernel ? 0 : page_size_);
+
+            mapping_ = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, flags, fd, 0);
+            if (mapping_ == MAP_FAILED)
+            {
+                throw std::runtime_error("Failed to map " + std::to_string(mapping_size_) + " bytes: " +
+                                         std::strerror(errno));
+            }
+
+            const auto address = reinterpret_cast<std::uintptr_t>(mapping_);
+            data_ = reinterpret_cast<unsigned char*>((address + (page_size_ - 1)) & ~(page_size_ - 1));
+        }
+
+        ~PageMapping() { munmap(mapping_, mapping_size_); }
+
+        PageMapping(const PageMapping&) = delete;
+        PageMapping& operator=(const PageMapping&) = delete;
+        PageMapping(PageMapping&&) = delete;
+        PageMapping& operator=(PageMapping&&) = delete;
+
+        [[nodiscard]] unsigned char* data() const noexcept { return data_; }
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] std::size_t page_size() const noexcept { return page_size_; }
+
+    private:
+        std::size_t page_size_;
+        std::size_t size_ = 0;
+        std::size_t mapping_size_ = 0;
+        void* mapping_ = nullptr;
+        unsigned char* data_ = nullptr;
+    };
+
+    // Page-aligned buffer of the given backend, rounded up to whole pages and unmapped on destruction
+    class MemoryBuffer
+    {
+    public:
+        MemoryBuffer(const std::size_t buffer_size_in_bytes, const MemoryBackend backend) : backend_(backend)
+        {
+            try
+            {
+                map(buffer_size_in_bytes);
+                apply_policy();
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+
+        ~MemoryBuffer() { release(); }
+
+        MemoryBuffer(const MemoryBuffer&) = delete;
+        MemoryBuffer& operator=(const MemoryBuffer&) = delete;
+        MemoryBuffer(MemoryBuffer&&) = delete;
+        MemoryBuffer& operator=(MemoryBuffer&&) = delete;
+
+        template <typename T>
+        [[nodiscard]] T* data() const noexcept
+        {
+            return reinterpret_cast<T*>(mapping_->data());
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return mapping_->size(); }
+        [[nodiscard]] std::size_t page_size() const noexcept { return mapping_->page_size(); }
+        [[nodiscard]] MemoryBackend backend() const noexcept { return backend_; }
+
+    private:
+        void map(const std::size_t buffer_size_in_bytes)
+        {
+            constexpr auto HUGE_2MB_SHIFT = 21;
+            constexpr auto HUGE_1GB_SHIFT = 30;
+
+            const auto page_size = get_page_size(backend_);
+            const auto size = (std::max(buffer_size_in_bytes, std::size_t{1}) + (page_size - 1)) & ~(page_size - 1);
+            auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+            switch (backend_)
+            {
+                case MemoryBackend::Hugetlb2M:
+                    flags |= MAP_HUGETLB | (HUGE_2MB_SHIFT << MAP_HUGE_SHIFT);
+                    break;
+                case MemoryBackend::Hugetlb1G:
+                    flags |= MAP_HUGETLB | (HUGE_1GB_SHIFT << MAP_HUGE_SHIFT);
+                    break;
+                case MemoryBackend::Memfd:
+                    fd_ = memfd_create("micro_benchmark_buffer", MFD_CLOEXEC);
+                    if (fd_ < 0 || ftruncate(fd_, static_cast<off_t>(size)) != 0)
+                    {
+                        throw std::runtime_error("Failed to create a memfd of " + std::to_string(size) +
+                                                 " bytes: " + std::strerror(errno));
+                    }
+                    flags = MAP_SHARED;
+                    break;
+                default:
+                    break;
+            }
+
+            try
+            {
+                mapping_.emplace(size, page_size, flags, fd_);
+            }
+            catch (const std::exception& e)
+            {
+                throw std::runtime_error("Failed to allocate " + std::string(to_string(backend_)) + " memory: " +
+                                         e.what());
+            }
+        }
+
+        void apply_policy()
+        {
+            auto* const data = mapping_->data();
+            const auto size = mapping_->size();
+            switch (backend_)
+            {
+                case MemoryBackend::Thp:
+                    advise_hugepage(data, size, true);
+                    break;
+                case MemoryBackend::Hugetlb2M:
+                case MemoryBackend::Hugetlb1G:
+                    break;
+                case MemoryBackend::Anonymous:
+                case MemoryBackend::Memfd:
+                    advise_hugepage(data, size, false);
+                    break;
+                case MemoryBackend::Locked:
+                    advise_hugepage(data, size, false);
+                    if (mlock(data, size) != 0)
+                    {
+                        throw std::runtime_error("Failed to lock " + std::to_string(size) +
+                                                 " bytes (see RLIMIT_MEMLOCK): " + std::strerror(errno));
+                    }
+                    break;
+                case MemoryBackend::NumaLocal:
+                    advise_hugepage(data, size, false);
+                    bind_memory_to_numa_node(data, size, get_current_numa_node());
+                    break;
+                case MemoryBackend::NumaInterleaved:
+                    advise_hugepage(data, size, false);
+                    interleave_memory_across_numa_nodes(data, size);
+                    break;
+            }
+        }
+
+        void release() noexcept
+        {
+            mapping_.reset();
+            if (fd_ >= 0)
+            {
+                close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        MemoryBackend backend_;
+        int fd_ = -1;
+        std::optional<PageMapping> mapping_;
+    };
+
+    // Physical frame number of every page of the buffer, read from /proc/self/pagemap. The kernel reports frame
+    // numbers only to processes with CAP_SYS_ADMIN, so this throws without it. Every page must already be faulted in.
+    [[nodiscard]] inline std::vector<std::uint64_t> get_physical_frame_numbers(const void* const buffer,
+                                                                               const std::size_t buffer_size_in_bytes)
+    {
+        constexpr auto PRESENT_BIT = std::uint64_t{1} << 63U;
+        constexpr auto FRAME_NUMBER_MASK = (std::uint64_t{1} << 55U) - 1;
+
+        const auto page_size = get_page_size();
+        const auto first_page = reinterpret_cast<std::uintptr_t>(buffer) / page_size;
+        const auto num_pages = (buffer_size_in_bytes + page_size - 1) / page_size;
+
+        auto pagemap = std::ifstream("/proc/self/pagemap", std::ios::binary);
+        if (!pagemap.is_open())
+        {
+            throw std::runtime_error("Failed to open /proc/self/pagemap.");
+        }
+
+        auto entries = std::vector<std::uint64_t>(num_pages);
+        pagemap.seekg(static_cast<std::streamoff>(first_page * sizeof(std::uint64_t)));
+        pagemap.read(reinterpret_cast<char*>(entries.data()),
+                     static_cast<std::streamsize>(num_pages * sizeof(std::uint64_t)));
+        if (!pagemap)
+        {
+            throw std::runtime_error("Failed to read /proc/self/pagemap.");
+        }
+
+        for (auto& entry : entries)
+        {
+            if ((entry & PRESENT_BIT) == 0)
+            {
+                throw std::runtime_error("Every page must be resident before reading its physical frame number.");
+            }
+
+            entry &= FRAME_NUMBER_MASK;
+            if (entry == 0)
+            {
+                throw std::runtime_error("Physical frame numbers are hidden; CAP_SYS_ADMIN is required.");
+            }
+        }
+        return entries;
+    }
+
+    // Number of page colors of a cache level: pages of different colors never compete for the same sets. Rounded down
+    // to a power of 2 so that the color is a bit field of the frame number; slice hashing of a shared L3 is not taken
+    // into account. Returns 1 when the geometry is unknown.
+    [[nodiscard]] inline std::size_t get_cache_page_colors(const std::int32_t level)
+    {
+        const auto size = sysconf(level == 2 ? _SC_LEVEL2_CACHE_SIZE : _SC_LEVEL3_CACHE_SIZE);
+        const auto ways = sysconf(level == 2 ? _SC_LEVEL2_CACHE_ASSOC : _SC_LEVEL3_CACHE_ASSOC);
+        if (size < 1 || ways < 1)
+        {
+            return 1;
+        }
+
+        const auto bytes_per_way = static_cast<std::size_t>(size) / static_cast<std::size_t>(ways);
+        auto num_colors = std::size_t{1};
+        while (num_colors * 2 * get_page_size() <= bytes_per_way)
+        {
+            num_colors *= 2;
+        }
+        return num_colors;
+    }
 }  // namespace common
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+
+namespace common
+{
+    // Anonymous mapping that machine code is appended to while it is writable and that `finalize` then mprotects to
+    // read+execute. Offsets are relative to the start of the code, which is page (or hugepage) aligned.
+    class JitBuffer
+    {
+    public:
+        JitBuffer(const std::size_t capacity_in_bytes, const bool use_hugepage)
+            : mapping_(capacity_in_bytes, use_hugepage ? get_hugepage_size() : get_page_size(),
+                       MAP_PRIVATE | MAP_ANONYMOUS),
+              code_(mapping_.data())
+        {
+            advise_hugepage(code_, mapping_.size(), use_hugepage);
+        }
+
+        ~JitBuffer() = default;
+
+        JitBuffer(const JitBuffer&) = delete;
+        JitBuffer& operator=(const JitBuffer&) = delete;
+        JitBuffer(JitBuffer&&) = delete;
+        JitBuffer& operator=(JitBuffer&&) = delete;
+
+        // Number of bytes emitted so far, i.e. the offset of the next byte
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+        [[nodiscard]] std::uintptr_t address_of(const std::size_t offset) const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(code_ + offset);
+        }
+
+        void emit(const std::initializer_list<std::uint8_t> bytes)
+        {
+            reserve(bytes.size());
+            for (const auto byte : bytes)
+            {
+                code_[size_++] = byte;
+            }
+        }
+
+        void emit_u32(const std::uint32_t value)
+        {
+            reserve(sizeof(value));
+            std::memcpy(code_ + size_, &value, sizeof(value));
+            size_ += sizeof(value);
+        }
+
+        // Displacement field of a jmp/jcc/call rel32 that ends right after the field
+        void emit_rel32(const std::size_t target_offset)
+        {
+            const auto displacement =
+                static_cast<std::int64_t>(target_offset) - static_cast<std::int64_t>(size_ + sizeof(std::int32_t));
+            emit_u32(static_cast<std::uint32_t>(static_cast<std::int32_t>(displacement)));
+        }
+
+        // Fills with `fill` up to `offset`, which must not be behind the current size
+        void pad_to(const std::size_t offset, const std::uint8_t fill)
+        {
+            if (offset < size_)
+            {
+                throw std::invalid_argument("`offset` must not be behind the emitted code.");
+            }
+
+            reserve(offset - size_);
+            std::memset(code_ + size_, fill, offset - size_);
+            size_ = offset;
+        }
+
+        void align(const std::size_t alignment, const std::uint8_t fill)
+        {
+            pad_to((size_ + (alignment - 1)) & ~(alignment - 1), fill);
+        }
+
+        // Makes the code executable; nothing may be emitted afterwards
+        void finalize()
+        {
+            if (mprotect(code_, mapping_.size(), PROT_READ | PROT_EXEC) != 0)
+            {
+                throw std::runtime_error("Failed to make the JIT buffer executable: " +
+                                         std::string(std::strerror(errno)));
+            }
+            is_finalized_ = true;
+        }
+
+        template <typename Function>
+        [[nodiscard]] Function get_function(const std::size_t offset) const
+        {
+            if (!is_finalized_)
+            {
+                throw std::logic_error("The JIT buffer must be finalized before its code is called.");
+            }
+            return reinterpret_cast<Function>(code_ + offset);
+        }
+
+    private:
+        void reserve(const std::size_t num_bytes) const
+        {
+            if (is_finalized_)
+            {
+                throw std::logic_error("Cannot emit code into a finalized JIT buffer.");
+            }
+            if (size_ + num_bytes > mapping_.size())
+            {
+                throw std::length_error("JIT buffer capacity of " + std::to_string(mapping_.size()) +
+                                        " bytes exceeded.");
+            }
+        }
+
+        PageMapping mapping_;
+        unsigned char* code_;
+        std::size_t size_ = 0;
+        bool is_finalized_ = false;
+    };
+
+}  // namespace common
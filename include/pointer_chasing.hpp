@@ -0,0 +1,336 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define REP10(x) x x x x x x x x x x
+#define REP100(x) REP10(REP10(x))
+#define REP1000(x) REP10(REP100(x))
+
+namespace common
+{
+    using MemoryAddress = void*;
+
+    namespace detail
+    {
+        [[nodiscard]] inline std::vector<std::size_t> generate_random_permutation(const std::size_t num_elements,
+                                                                                  const std::uint64_t seed)
+        {
+            auto indices = std::vector<std::size_t>(num_elements);
+            std::iota(indices.begin(), indices.end(), 0);
+
+            auto rng = std::mt19937_64(seed);
+            std::shuffle(indices.begin(), indices.end(), rng);
+
+            return indices;
+        }
+
+        [[nodiscard]] inline unsigned char* get_element_location(MemoryAddress* const buffer, const std::size_t index,
+                                                                 const std::size_t padded_bytes_per_element,
+                                                                 const std::size_t element_offset) noexcept
+        {
+            return reinterpret_cast<unsigned char*>(buffer) + (index * padded_bytes_per_element) + element_offset;
+        }
+
+        // rdtscp waits for every preceding load to complete, and the lfence keeps later loads from starting before the
+        // counter is read
+        [[nodiscard]] inline std::uint64_t read_timestamp() noexcept
+        {
+            auto low = std::uint32_t{0};
+            auto high = std::uint32_t{0};
+            __asm__ volatile("rdtscp\n\tlfence\n\t" : "=a"(low), "=d"(high) : : "rcx", "memory");
+            return (std::uint64_t{high} << 32U) | low;
+        }
+
+        // The location may be unaligned, so the pointer is written bytewise
+        inline void store_pointer(unsigned char* const location, unsigned char* const target) noexcept
+        {
+            const auto value = reinterpret_cast<MemoryAddress>(target);
+            std::memcpy(location, &value, sizeof(value));
+        }
+
+        // Draws ranks in [1, num_ranks] with probability proportional to `rank^-skew`, by rejection-inversion (Hormann
+        // and Derflinger, 1996), in constant time per draw without a table of the distribution
+        class ZipfianSampler
+        {
+        public:
+            ZipfianSampler(const std::size_t num_ranks, const double skew)
+                : num_ranks_(num_ranks), skew_(skew), h_integral_x1_(h_integral(1.5) - 1.0),
+                  h_integral_num_ranks_(h_integral(static_cast<double>(num_ranks) + 0.5)),
+                  s_(2.0 - h_integral_inverse(h_integral(2.5) - h(2.0)))
+            {
+                if (num_ranks == 0 || !(skew >= 0.0))
+                {
+                    throw std::invalid_argument("A Zipfian distribution needs ranks and a non-negative skew.");
+                }
+            }
+
+            template <typename Rng>
+            [[nodiscard]] std::size_t operator()(Rng& rng)
+            {
+                auto uniform = std::uniform_real_distribution<double>(0.0, 1.0);
+                while (true)
+                {
+                    const auto u = h_integral_num_ranks_ + (uniform(rng) * (h_integral_x1_ - h_integral_num_ranks_));
+                    const auto x = h_integral_inverse(u);
+                    const auto rank = std::clamp(static_cast<std::size_t>(x + 0.5), std::size_t{1}, num_ranks_);
+                    const auto k = static_cast<double>(rank);
+                    if (k - x <= s_ || u >= h_integral(k + 0.5) - h(k))
+                    {
+                        return rank;
+                    }
+                }
+            }
+
+        private:
+            // log1p(x) / x and expm1(x) / x, kept accurate near 0
+            [[nodiscard]] static double helper1(const double x)
+            {
+                return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - (x * (0.5 - (x * ((1.0 / 3.0) - (0.25 * x)))));
+            }
+
+            [[nodiscard]] static double helper2(const double x)
+            {
+                return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + (x * 0.5 * (1.0 + (x / 3.0 * (1.0 + 0.25 * x))));
+            }
+
+            [[nodiscard]] double h(const double x) const { return std::exp(-skew_ * std::log(x)); }
+
+            [[nodiscard]] double h_integral(const double x) const
+            {
+                const auto log_x = std::log(x);
+                return helper2((1.0 - skew_) * log_x) * log_x;
+            }
+
+            [[nodiscard]] double h_integral_inverse(const double x) const
+            {
+                const auto t = std::max(x * (1.0 - skew_), -1.0);
+                return std::exp(helper1(t) * x);
+            }
+
+            std::size_t num_ranks_;
+            double skew_;
+            double h_integral_x1_;
+            double h_integral_num_ranks_;
+            double s_;
+        };
+
+        // Zeroes the first word of every element and returns the offset of each visited element. `element_of_visit`
+        // gives the index of the element of each visit.
+        template <typename ElementOfVisit>
+        [[nodiscard]] std::vector<std::uint32_t> generate_visits(MemoryAddress* const buffer,
+                                                                 const std::size_t num_elements,
+                                                                 const std::size_t padded_bytes_per_element,
+                                                                 const std::size_t num_visits,
+                                                                 ElementOfVisit&& element_of_visit)
+        {
+            if (padded_bytes_per_element < sizeof(MemoryAddress))
+            {
+                throw std::invalid_argument("`padded_bytes_per_element` must be at least " +
+                                            std::to_string(sizeof(MemoryAddress)) + ".");
+            }
+            if (num_elements * padded_bytes_per_element > std::numeric_limits<std::uint32_t>::max())
+            {
+                throw std::invalid_argument("Skewed chases only cover buffers below 4 GiB.");
+            }
+
+            for (std::size_t i = 0; i < num_elements; ++i)
+            {
+                std::memset(get_element_location(buffer, i, padded_bytes_per_element, 0), 0, sizeof(MemoryAddress));
+            }
+
+            auto offsets = std::vector<std::uint32_t>(num_visits);
+            for (auto& offset : offsets)
+            {
+                offset = static_cast<std::uint32_t>(element_of_visit() * padded_bytes_per_element);
+            }
+            return offsets;
+        }
+    }  // namespace detail
+
+    // A plain chain visits every element once per lap, so its accesses are uniform. A skewed chase instead follows a
+    // precomputed sequence of element offsets, from `generate_zipfian_visits` or `generate_hot_set_visits`, and adds
+    // the value loaded from each element (always 0) to the next offset, so the element loads still depend on each
+    // other. The offsets are read sequentially, off the dependency chain, at 4 bytes per visit.
+
+    // Visits follow a Zipfian distribution of the given skew (0 is uniform). Ranks are assigned to elements at random,
+    // so the hot elements are scattered over the buffer.
+    [[nodiscard]] inline std::vector<std::uint32_t> generate_zipfian_visits(MemoryAddress* const buffer,
+                                                                            const std::size_t num_elements,
+                                                                            const std::size_t padded_bytes_per_element,
+                                                                            const std::size_t num_visits,
+                                                                            const double skew, const std::uint64_t seed)
+    {
+        const auto elements = detail::generate_random_permutation(num_elements, seed);
+        auto sampler = detail::ZipfianSampler(num_elements, skew);
+        // A stream apart from the permutation's, so that which elements are hot does not depend on the ranks drawn
+        auto rng = std::mt19937_64(seed + 1);
+        return detail::generate_visits(buffer, num_elements, padded_bytes_per_element, num_visits,
+                                       [&] { return elements[sampler(rng) - 1]; });
+    }
+
+    // A random `hot_fraction` of the elements receives `hot_probability` of the visits; both sets are uniform inside
+    [[nodiscard]] inline std::vector<std::uint32_t> generate_hot_set_visits(MemoryAddress* const buffer,
+                                                                            const std::size_t num_elements,
+                                                                            const std::size_t padded_bytes_per_element,
+                                                                            const std::size_t num_visits,
+                                                                            const double hot_fraction,
+                                                                            const double hot_probability,
+                                                                            const std::uint64_t seed)
+    {
+        if (!(hot_fraction > 0.0 && hot_fraction < 1.0) || !(hot_probability >= 0.0 && hot_probability <= 1.0))
+        {
+            throw std::invalid_argument("`hot_fraction` must be in (0, 1) and `hot_probability` in [0, 1].");
+        }
+
+        const auto elements = detail::generate_random_permutation(num_elements, seed);
+        const auto num_hot = std::clamp(static_cast<std::size_t>(hot_fraction * static_cast<double>(num_elements)),
+                                        std::size_t{1}, num_elements);
+
+        auto rng = std::mt19937_64(seed + 1);
+        auto is_hot = std::bernoulli_distribution(hot_probability);
+        auto hot = std::uniform_int_distribution<std::size_t>(0, num_hot - 1);
+        auto cold = std::uniform_int_distribution<std::size_t>(num_hot < num_elements ? num_hot : 0, num_elements - 1);
+        return detail::generate_visits(buffer, num_elements, padded_bytes_per_element, num_visits,
+                                       [&] { return elements[is_hot(rng) ? hot(rng) : cold(rng)]; });
+    }
+
+    // Each element holds its link at byte `element_offset`, and every link points at the link of the next element, so
+    // a chase only ever loads from that offset. An offset that places the link across a cache-line or page boundary
+    // turns every load of the chase into a split load. The link of the last element then extends past the buffer by
+    // `element_offset + sizeof(MemoryAddress) - padded_bytes_per_element` bytes, which the buffer must also cover.
+    [[nodiscard]] inline MemoryAddress* generate_random_pointer_chasing(MemoryAddress* const buffer,
+                                                                        const std::size_t num_elements,
+                                                                        const std::size_t padded_bytes_per_element,
+                                                                        const std::uint64_t seed,
+                                                                        const std::size_t element_offset = 0)
+    {
+        if (buffer == nullptr || num_elements == 0)
+        {
+            return nullptr;
+        }
+
+        if (padded_bytes_per_element < sizeof(MemoryAddress))
+        {
+            throw std::invalid_argument("`padded_bytes_per_element` must be at least " +
+                                        std::to_string(sizeof(MemoryAddress)) + ".");
+        }
+
+        if (element_offset >= padded_bytes_per_element)
+        {
+            throw std::invalid_argument("`element_offset` must be less than `padded_bytes_per_element`.");
+        }
+
+        const auto indices = detail::generate_random_permutation(num_elements, seed);
+        const auto location = [&](const std::size_t index) {
+            return detail::get_element_location(buffer, index, padded_bytes_per_element, element_offset);
+        };
+
+        // Link elements according to the shuffled indices
+        for (std::size_t i = 0; i < num_elements - 1; ++i)
+        {
+            // indices[i] -> indices[i+1]
+            detail::store_pointer(location(indices[i]), location(indices[i + 1]));
+        }
+
+        // indices[num_elements-1] -> indices[0]
+        detail::store_pointer(location(indices[num_elements - 1]), location(indices[0]));
+
+        // Return the entry point of the cyclic list
+        return reinterpret_cast<MemoryAddress*>(location(indices[0]));
+    }
+
+    // Links the given elements, which may lie anywhere, into a single random cycle
+    [[nodiscard]] inline MemoryAddress* link_random_pointer_chasing(const std::vector<MemoryAddress*>& elements,
+                                                                    const std::uint64_t seed)
+    {
+        if (elements.empty())
+        {
+            return nullptr;
+        }
+
+        const auto indices = detail::generate_random_permutation(elements.size(), seed);
+        for (std::size_t i = 0; i < elements.size(); ++i)
+        {
+            // indices[i] -> indices[i+1], wrapping around at the end
+            *elements[indices[i]] = elements[indices[(i + 1) % elements.size()]];
+        }
+
+        // Return the entry point of the cyclic list
+        return elements[indices[0]];
+    }
+
+    template <std::int32_t NUM_STEPS>
+    MemoryAddress* walk_pointer_chain(MemoryAddress* const start_ptr)
+    {
+        constexpr auto UNROLL_COUNT = std::int32_t{1000};
+        static_assert(NUM_STEPS % UNROLL_COUNT == 0, "`NUM_STEPS` must be a multiple of `UNROLL_COUNT`");
+
+        auto* current_ptr = start_ptr;
+        for (std::int32_t i = 0; i < NUM_STEPS; i += UNROLL_COUNT)
+        {
+            // current_ptr = *current_ptr
+            __asm__ volatile(REP1000("mov (%0), %0\n\t") : "+r"(current_ptr) : : "memory");
+        }
+        return current_ptr;
+    }
+
+    // Like `walk_pointer_chain`, but reads the TSC every `SAMPLE_INTERVAL` loads. Writes `num_samples + 1` timestamps,
+    // so that `timestamps[i + 1] - timestamps[i]` is the time taken by the i-th group of loads.
+    template <std::int32_t SAMPLE_INTERVAL>
+    MemoryAddress* walk_pointer_chain_sampled(MemoryAddress* const start_ptr, std::uint64_t* const timestamps,
+                                              const std::size_t num_samples)
+    {
+        static_assert(SAMPLE_INTERVAL >= 0, "`SAMPLE_INTERVAL` must not be negative");
+
+        auto* current_ptr = start_ptr;
+        timestamps[0] = detail::read_timestamp();
+        for (std::size_t i = 1; i <= num_samples; ++i)
+        {
+            for (std::int32_t j = 0; j < SAMPLE_INTERVAL; ++j)
+            {
+                // current_ptr = *current_ptr
+                __asm__ volatile("mov (%0), %0\n\t" : "+r"(current_ptr) : : "memory");
+            }
+            timestamps[i] = detail::read_timestamp();
+        }
+        return current_ptr;
+    }
+
+    // Runs `NUM_STEPS` visits of a skewed chase from `offsets`, which must hold that many
+    template <std::int32_t NUM_STEPS>
+    void walk_visits(const MemoryAddress* const buffer, const std::uint32_t* const offsets)
+    {
+        constexpr auto UNROLL_COUNT = std::int32_t{1000};
+        static_assert(NUM_STEPS % UNROLL_COUNT == 0, "`NUM_STEPS` must be a multiple of `UNROLL_COUNT`");
+
+        auto* current_offset = offsets;
+        auto value = std::uint64_t{0};
+        for (std::int32_t i = 0; i < NUM_STEPS; i += UNROLL_COUNT)
+        {
+            // value = *(buffer + *current_offset++ + value)
+            __asm__ volatile(REP1000("mov (%0), %%eax\n\t"
+                                     "add %1, %%rax\n\t"
+                                     "mov (%2, %%rax), %1\n\t"
+                                     "add $4, %0\n\t")
+                             : "+r"(current_offset), "+r"(value)
+                             : "r"(buffer)
+                             : "rax", "memory");
+        }
+    }
+
+}  // namespace common
+
+#undef REP1000
+#undef REP100
+#undef REP10
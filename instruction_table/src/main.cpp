@@ -0,0 +1,193 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace instruction_table
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    struct InstructionInfo
+    {
+        const char* name;
+        Kernel latency_kernel;
+        Kernel throughput_kernel;
+    };
+
+#define INSTRUCTION_TABLE_ENTRY(NAME) InstructionInfo{#NAME, NAME##_latency, NAME##_throughput}
+
+    // Instructions whose ISA extension the compiler was not targeting are left out
+    const auto INSTRUCTIONS = std::vector<InstructionInfo>{
+        INSTRUCTION_TABLE_ENTRY(add),
+        INSTRUCTION_TABLE_ENTRY(lea3),
+        INSTRUCTION_TABLE_ENTRY(imul64),
+        INSTRUCTION_TABLE_ENTRY(div32),
+        INSTRUCTION_TABLE_ENTRY(div64),
+#ifdef __POPCNT__
+        INSTRUCTION_TABLE_ENTRY(popcnt),
+#endif
+#ifdef __BMI2__
+        INSTRUCTION_TABLE_ENTRY(pdep),
+        INSTRUCTION_TABLE_ENTRY(pext),
+#endif
+#ifdef __SSE4_2__
+        INSTRUCTION_TABLE_ENTRY(crc32),
+#endif
+#ifdef __AVX2__
+        INSTRUCTION_TABLE_ENTRY(vpaddd),
+        INSTRUCTION_TABLE_ENTRY(vpshufb),
+        INSTRUCTION_TABLE_ENTRY(vpermd),
+        INSTRUCTION_TABLE_ENTRY(vaddps),
+        INSTRUCTION_TABLE_ENTRY(vmulps),
+        INSTRUCTION_TABLE_ENTRY(vdivps),
+        INSTRUCTION_TABLE_ENTRY(vpgatherdd),
+#endif
+#ifdef __FMA__
+        INSTRUCTION_TABLE_ENTRY(vfmadd231ps),
+#endif
+    };
+
+#undef INSTRUCTION_TABLE_ENTRY
+
+    struct BenchmarkResult
+    {
+        const std::string& cpu_model;
+        const std::int32_t cpu;
+        const char* const instruction;
+        double latency_cycles = 0.0;
+        double reciprocal_throughput_cycles = 0.0;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "CpuModel,Cpu,Instruction,LatencyCycles,ReciprocalThroughputCycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << result.cpu_model << "," << result.cpu << "," << result.instruction << ","
+                  << result.latency_cycles << "," << result.reciprocal_throughput_cycles << "\n";
+    }
+
+    // The "model name" of /proc/cpuinfo with commas removed so that it fits in a CSV field
+    [[nodiscard]] std::string get_cpu_model_name()
+    {
+        auto cpuinfo = std::ifstream("/proc/cpuinfo");
+        auto line = std::string();
+        while (std::getline(cpuinfo, line))
+        {
+            if (line.rfind("model name", 0) != 0)
+            {
+                continue;
+            }
+
+            const auto colon = line.find(':');
+            auto name = colon == std::string::npos ? std::string() : line.substr(colon + 1);
+            name.erase(0, name.find_first_not_of(' '));
+            std::replace(name.begin(), name.end(), ',', ' ');
+            return name;
+        }
+        return "Unknown";
+    }
+
+    // Minimum number of cycles per instruction over the trials
+    [[nodiscard]] double measure_cycles_per_instruction(perf_counter* const cycle_counter, const Kernel kernel,
+                                                        const std::int32_t block_size)
+    {
+        constexpr auto NUM_BLOCKS = std::int32_t{10'000};
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+
+        auto min_cycles = std::numeric_limits<std::uint64_t>::max();
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_cycles = perf_counter_read(cycle_counter);
+            kernel(NUM_BLOCKS);
+            const auto end_cycles = perf_counter_read(cycle_counter);
+
+            if (i >= NUM_WARMUPS)
+            {
+                min_cycles = std::min(min_cycles, end_cycles - start_cycles);
+            }
+        }
+
+        return static_cast<double>(min_cycles) / (static_cast<double>(NUM_BLOCKS) * static_cast<double>(block_size));
+    }
+
+    void run_benchmark(const InstructionInfo& info, const std::string& cpu_model, const std::int32_t cpu)
+    {
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        auto result = BenchmarkResult{cpu_model, cpu, info.name};
+        result.latency_cycles = measure_cycles_per_instruction(&cycle_counter, info.latency_kernel, LATENCY_BLOCK_SIZE);
+        result.reciprocal_throughput_cycles =
+            measure_cycles_per_instruction(&cycle_counter, info.throughput_kernel, THROUGHPUT_BLOCK_SIZE);
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+}  // namespace instruction_table
+
+// Usage: instruction_table [instruction...]
+// Measures the listed instructions, or every instruction in the table when none is given.
+int main(int argc, char* argv[])
+{
+    instruction_table::print_csv_header();
+
+    try
+    {
+        auto selected = std::vector<instruction_table::InstructionInfo>();
+        for (int i = 1; i < argc; ++i)
+        {
+            const auto name = std::string(argv[i]);
+            const auto it = std::find_if(instruction_table::INSTRUCTIONS.begin(), instruction_table::INSTRUCTIONS.end(),
+                                         [&](const auto& info) { return name == info.name; });
+            if (it == instruction_table::INSTRUCTIONS.end())
+            {
+                throw std::invalid_argument("Unknown or unsupported instruction '" + name + "'.");
+            }
+            selected.push_back(*it);
+        }
+        if (selected.empty())
+        {
+            selected = instruction_table::INSTRUCTIONS;
+        }
+
+        // Stay on one CPU so that every row describes the same core type on hybrid parts
+        const auto cpu = common::get_available_cpus().front();
+        common::pin_current_thread_to_cpu(cpu);
+
+        const auto cpu_model = instruction_table::get_cpu_model_name();
+        for (const auto& info : selected)
+        {
+            instruction_table::run_benchmark(info, cpu_model, cpu);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <immintrin.h>
+#include <cstdint>
+
+#define REP5(x) x x x x x
+#define REP8(x) x x x x x x x x
+#define REP10(x) x x x x x x x x x x
+#define REP100(x) REP10(REP10(x))
+
+// Every instruction gets a latency kernel, a dependent chain of `LATENCY_BLOCK_SIZE` instructions through one
+// register, and a throughput kernel, `THROUGHPUT_BLOCK_SIZE` instructions spread round-robin over eight independent
+// registers. Both take the number of blocks to execute.
+namespace instruction_table
+{
+    constexpr auto LATENCY_BLOCK_SIZE = std::int32_t{100};
+    constexpr auto THROUGHPUT_BLOCK_SIZE = std::int32_t{80};
+
+    // Second operand of the general-purpose instructions and the pdep/pext mask, whose popcount sets the latency of
+    // the microcoded pdep/pext on Zen 1 and 2
+    constexpr auto GPR_SOURCE = std::uint64_t{0x5555'5555'5555'5555};
+
+    // Bit pattern of 1.0f in every lane: a normal float for the FP instructions and a valid index for the shuffles
+    constexpr auto VECTOR_SOURCE = std::int32_t{0x3F80'0000};
+
+    using Kernel = void (*)(std::int32_t num_blocks);
+
+// `INSTRUCTION(dst)` expands to the assembly of one instruction that reads and writes the register `dst` and may
+// read `%[src]`
+#define INSTRUCTION_TABLE_DEFINE(NAME, INSTRUCTION, TYPE, CONSTRAINT, SOURCE)                                         \
+    inline void NAME##_latency(const std::int32_t num_blocks) noexcept                                                \
+    {                                                                                                                  \
+        auto r0 = TYPE(SOURCE);                                                                                        \
+        const auto src = TYPE(SOURCE);                                                                                 \
+        for (std::int32_t i = 0; i < num_blocks; ++i)                                                                  \
+        {                                                                                                              \
+            __asm__ volatile(REP100(INSTRUCTION("%[r0]")) : [r0] "+" CONSTRAINT(r0) : [src] CONSTRAINT(src) : "cc");  \
+        }                                                                                                              \
+    }                                                                                                                  \
+                                                                                                                       \
+    inline void NAME##_throughput(const std::int32_t num_blocks) noexcept                                             \
+    {                                                                                                                  \
+        auto r0 = TYPE(SOURCE);                                                                                        \
+        auto r1 = TYPE(SOURCE);                                                                                        \
+        auto r2 = TYPE(SOURCE);                                                                                        \
+        auto r3 = TYPE(SOURCE);                                                                                        \
+        auto r4 = TYPE(SOURCE);                                                                                        \
+        auto r5 = TYPE(SOURCE);                                                                                        \
+        auto r6 = TYPE(SOURCE);                                                                                        \
+        auto r7 = TYPE(SOURCE);                                                                                        \
+        const auto src = TYPE(SOURCE);                                                                                 \
+        for (std::int32_t i = 0; i < num_blocks; ++i)                                                                  \
+        {                                                                                                              \
+            __asm__ volatile(REP10(INSTRUCTION("%[r0]") INSTRUCTION("%[r1]") INSTRUCTION("%[r2]")                      \
+                                       INSTRUCTION("%[r3]") INSTRUCTION("%[r4]") INSTRUCTION("%[r5]")                  \
+                                           INSTRUCTION("%[r6]") INSTRUCTION("%[r7]"))                                  \
+                             : [r0] "+" CONSTRAINT(r0), [r1] "+" CONSTRAINT(r1), [r2] "+" CONSTRAINT(r2),              \
+                               [r3] "+" CONSTRAINT(r3), [r4] "+" CONSTRAINT(r4), [r5] "+" CONSTRAINT(r5),              \
+                               [r6] "+" CONSTRAINT(r6), [r7] "+" CONSTRAINT(r7)                                        \
+                             : [src] CONSTRAINT(src)                                                                   \
+                             : "cc");                                                                                  \
+        }                                                                                                              \
+    }
+
+#define INSTRUCTION_TABLE_GPR(value) std::uint64_t{value}
+#define INSTRUCTION_TABLE_YMM(value) _mm256_set1_epi32(value)
+
+#define INSTRUCTION_TABLE_DEFINE_GPR(NAME, INSTRUCTION) \
+    INSTRUCTION_TABLE_DEFINE(NAME, INSTRUCTION, INSTRUCTION_TABLE_GPR, "r", GPR_SOURCE)
+#define INSTRUCTION_TABLE_DEFINE_YMM(NAME, INSTRUCTION) \
+    INSTRUCTION_TABLE_DEFINE(NAME, INSTRUCTION, INSTRUCTION_TABLE_YMM, "x", VECTOR_SOURCE)
+
+#define ADD(dst) "add %[src], " dst "\n\t"
+#define LEA3(dst) "lea 1(" dst ", %[src], 2), " dst "\n\t"
+#define IMUL64(dst) "imul %[src], " dst "\n\t"
+#define POPCNT(dst) "popcnt " dst ", " dst "\n\t"
+#define PDEP(dst) "pdep %[src], " dst ", " dst "\n\t"
+#define PEXT(dst) "pext %[src], " dst ", " dst "\n\t"
+#define CRC32(dst) "crc32q %[src], " dst "\n\t"
+#define VPADDD(dst) "vpaddd %[src], " dst ", " dst "\n\t"
+#define VPSHUFB(dst) "vpshufb %[src], " dst ", " dst "\n\t"
+#define VPERMD(dst) "vpermd " dst ", %[src], " dst "\n\t"
+#define VADDPS(dst) "vaddps %[src], " dst ", " dst "\n\t"
+#define VMULPS(dst) "vmulps %[src], " dst ", " dst "\n\t"
+#define VDIVPS(dst) "vdivps %[src], " dst ", " dst "\n\t"
+#define VFMADD231PS(dst) "vfmadd231ps %[src], %[src], " dst "\n\t"
+
+    INSTRUCTION_TABLE_DEFINE_GPR(add, ADD)
+    INSTRUCTION_TABLE_DEFINE_GPR(lea3, LEA3)
+    INSTRUCTION_TABLE_DEFINE_GPR(imul64, IMUL64)
+#ifdef __POPCNT__
+    INSTRUCTION_TABLE_DEFINE_GPR(popcnt, POPCNT)
+#endif
+#ifdef __BMI2__
+    INSTRUCTION_TABLE_DEFINE_GPR(pdep, PDEP)
+    INSTRUCTION_TABLE_DEFINE_GPR(pext, PEXT)
+#endif
+#ifdef __SSE4_2__
+    INSTRUCTION_TABLE_DEFINE_GPR(crc32, CRC32)
+#endif
+#ifdef __AVX2__
+    INSTRUCTION_TABLE_DEFINE_YMM(vpaddd, VPADDD)
+    INSTRUCTION_TABLE_DEFINE_YMM(vpshufb, VPSHUFB)
+    INSTRUCTION_TABLE_DEFINE_YMM(vpermd, VPERMD)
+    INSTRUCTION_TABLE_DEFINE_YMM(vaddps, VADDPS)
+    INSTRUCTION_TABLE_DEFINE_YMM(vmulps, VMULPS)
+    INSTRUCTION_TABLE_DEFINE_YMM(vdivps, VDIVPS)
+#endif
+#ifdef __FMA__
+    INSTRUCTION_TABLE_DEFINE_YMM(vfmadd231ps, VFMADD231PS)
+#endif
+
+#undef VFMADD231PS
+#undef VDIVPS
+#undef VMULPS
+#undef VADDPS
+#undef VPERMD
+#undef VPSHUFB
+#undef VPADDD
+#undef CRC32
+#undef PEXT
+#undef PDEP
+#undef POPCNT
+#undef IMUL64
+#undef LEA3
+#undef ADD
+#undef INSTRUCTION_TABLE_DEFINE_YMM
+#undef INSTRUCTION_TABLE_DEFINE_GPR
+#undef INSTRUCTION_TABLE_YMM
+#undef INSTRUCTION_TABLE_GPR
+#undef INSTRUCTION_TABLE_DEFINE
+
+    // div takes its dividend in rdx:rax (edx:eax), so the latency chain runs through the quotient in rax and the
+    // throughput kernel reloads rax before every division. A divisor of 1 keeps the quotient as wide as the dividend,
+    // which is the slow case on CPUs whose divider has a data-dependent latency.
+    constexpr auto DIVIDEND = std::uint64_t{0x7FFF'FFFF'FFFF'FFFF};
+
+    inline void div64_latency(const std::int32_t num_blocks) noexcept
+    {
+        auto quotient = DIVIDEND;
+        const auto divisor = std::uint64_t{1};
+        for (std::int32_t i = 0; i < num_blocks; ++i)
+        {
+            __asm__ volatile(REP100("xor %%edx, %%edx\n\t"
+                                    "divq %[divisor]\n\t")
+                             : "+a"(quotient)
+                             : [divisor] "r"(divisor)
+                             : "rdx", "cc");
+        }
+    }
+
+    inline void div64_throughput(const std::int32_t num_blocks) noexcept
+    {
+        const auto divisor = std::uint64_t{1};
+        for (std::int32_t i = 0; i < num_blocks; ++i)
+        {
+            __asm__ volatile(REP10(REP8("mov %[dividend], %%rax\n\t"
+                                        "xor %%edx, %%edx\n\t"
+                                        "divq %[divisor]\n\t"))
+                             :
+                             : [dividend] "r"(DIVIDEND), [divisor] "r"(divisor)
+                             : "rax", "rdx", "cc");
+        }
+    }
+
+    inline void div32_latency(const std::int32_t num_blocks) noexcept
+    {
+        auto quotient = static_cast<std::uint32_t>(DIVIDEND);
+        const auto divisor = std::uint32_t{1};
+        for (std::int32_t i = 0; i < num_blocks; ++i)
+        {
+            __asm__ volatile(REP100("xor %%edx, %%edx\n\t"
+                                    "divl %[divisor]\n\t")
+                             : "+a"(quotient)
+                             : [divisor] "r"(divisor)
+                             : "rdx", "cc");
+        }
+    }
+
+    inline void div32_throughput(const std::int32_t num_blocks) noexcept
+    {
+        const auto divisor = std::uint32_t{1};
+        for (std::int32_t i = 0; i < num_blocks; ++i)
+        {
+            __asm__ volatile(REP10(REP8("mov %[dividend], %%eax\n\t"
+                                        "xor %%edx, %%edx\n\t"
+                                        "divl %[divisor]\n\t"))
+                             :
+                             : [dividend] "r"(static_cast<std::uint32_t>(DIVIDEND)), [divisor] "r"(divisor)
+                             : "rax", "rdx", "cc");
+        }
+    }
+
+#ifdef __AVX2__
+    namespace detail
+    {
+        // Gathers read this all-zero table, so every gathered index is 0 again
+        alignas(64) inline const std::int32_t GATHER_TABLE[8] = {};
+    }  // namespace detail
+
+    // vpgatherdd clears its mask, so each gather is preceded by a dependency-breaking vpcmpeqd that sets it again. The
+    // index and destination registers must differ, so the latency chain alternates between two registers.
+    inline void vpgatherdd_latency(const std::int32_t num_blocks) noexcept
+    {
+        auto a = _mm256_setzero_si256();
+        auto b = _mm256_setzero_si256();
+        auto mask = _mm256_setzero_si256();
+        for (std::int32_t i = 0; i < num_blocks; ++i)
+        {
+            __asm__ volatile(REP10(REP5("vpcmpeqd %[mask], %[mask], %[mask]\n\t"
+                                        "vpgatherdd %[mask], (%[table], %[a], 4), %[b]\n\t"
+                                        "vpcmpeqd %[mask], %[mask], %[mask]\n\t"
+                                        "vpgatherdd %[mask], (%[table], %[b], 4), %[a]\n\t"))
+                             : [a] "+&x"(a), [b] "+&x"(b), [mask] "+&x"(mask)
+                             : [table] "r"(detail::GATHER_TABLE)
+                             : "memory");
+        }
+    }
+
+#define GATHER(dst)                                                                                                    \
+    "vpcmpeqd %[mask], %[mask], %[mask]\n\t"                                                                          \
+    "vpgatherdd %[mask], (%[table], %[index], 4), " dst "\n\t"
+
+    inline void vpgatherdd_throughput(const std::int32_t num_blocks) noexcept
+    {
+        const auto index = _mm256_setzero_si256();
+        auto r0 = _mm256_setzero_si256();
+        auto r1 = _mm256_setzero_si256();
+        auto r2 = _mm256_setzero_si256();
+        auto r3 = _mm256_setzero_si256();
+        auto r4 = _mm256_setzero_si256();
+        auto r5 = _mm256_setzero_si256();
+        auto r6 = _mm256_setzero_si256();
+        auto r7 = _mm256_setzero_si256();
+        auto mask = _mm256_setzero_si256();
+        for (std::int32_t i = 0; i < num_blocks; ++i)
+        {
+            __asm__ volatile(REP10(GATHER("%[r0]") GATHER("%[r1]") GATHER("%[r2]") GATHER("%[r3]") GATHER("%[r4]")
+                                       GATHER("%[r5]") GATHER("%[r6]") GATHER("%[r7]"))
+                             : [r0] "+&x"(r0), [r1] "+&x"(r1), [r2] "+&x"(r2), [r3] "+&x"(r3), [r4] "+&x"(r4),
+                               [r5] "+&x"(r5), [r6] "+&x"(r6), [r7] "+&x"(r7), [mask] "+&x"(mask)
+                             : [table] "r"(detail::GATHER_TABLE), [index] "x"(index)
+                             : "memory");
+        }
+    }
+
+#undef GATHER
+#endif
+
+}  // namespace instruction_table
+
+#undef REP100
+#undef REP10
+#undef REP8
+#undef REP5
@@ -0,0 +1,192 @@
+#include "common.hpp"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <x86intrin.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace l3_slice_map
+{
+    constexpr auto NUM_SETS = std::size_t{64};
+    constexpr auto NUM_LAPS = std::size_t{200};
+    constexpr auto NUM_WARMUP_LAPS = std::size_t{20};
+
+    // One chain per L2 set index; together they spread lines over every slice
+    struct ChainInfo
+    {
+        common::MemoryAddress* start_ptr;
+        // Lines in load order, so that position `i` of a lap is `order[i]`
+        std::vector<common::MemoryAddress*> order;
+    };
+
+    struct SliceGroup
+    {
+        const std::int32_t cpu;
+        const std::int32_t nearest_cpu;
+        const std::size_t num_lines;
+        const std::uint64_t median_latency;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Cpu,NearestCpu,NumLines,MedianLatencyTscTicks\n";
+    }
+
+    void print_csv_row(const SliceGroup& group)
+    {
+        std::cout << group.cpu << "," << group.nearest_cpu << "," << group.num_lines << "," << group.median_latency
+                  << "\n";
+    }
+
+    // Latency of every line of every chain, in chain order, as seen from the calling thread's CPU
+    [[nodiscard]] std::vector<std::uint64_t> measure_line_latencies(const std::vector<ChainInfo>& chains,
+                                                                    const std::uint64_t timer_overhead)
+    {
+        auto* volatile kernel = common::walk_pointer_chain_sampled<1>;
+
+        auto latencies = std::vector<std::uint64_t>();
+        for (const auto& chain : chains)
+        {
+            const auto num_lines = chain.order.size();
+            auto timestamps = std::vector<std::uint64_t>((NUM_LAPS * num_lines) + 1);
+
+            // Lines may still sit in the private caches of the previous CPU; flushing them makes this CPU reload them
+            // into its own hierarchy, from which the chain evicts them into the L3
+            for (auto* const line : chain.order)
+            {
+                _mm_clflush(line);
+            }
+            _mm_mfence();
+
+            kernel(chain.start_ptr, timestamps.data(), NUM_WARMUP_LAPS * num_lines);
+            kernel(chain.start_ptr, timestamps.data(), NUM_LAPS * num_lines);
+
+            const auto position_latencies = get_position_latencies(timestamps, num_lines, timer_overhead);
+            latencies.insert(latencies.end(), position_latencies.begin(), position_latencies.end());
+        }
+        return latencies;
+    }
+
+    // Samples without any loads in between
+    [[nodiscard]] std::uint64_t measure_timer_overhead()
+    {
+        constexpr auto NUM_SAMPLES = std::size_t{100'000};
+
+        auto timestamps = std::vector<std::uint64_t>(NUM_SAMPLES + 1);
+        auto* volatile kernel = common::walk_pointer_chain_sampled<0>;
+        kernel(nullptr, timestamps.data(), NUM_SAMPLES);
+
+        auto overhead = timestamps[1] - timestamps[0];
+        for (std::size_t i = 2; i < timestamps.size(); ++i)
+        {
+            overhead = std::min(overhead, timestamps[i] - timestamps[i - 1]);
+        }
+        return overhead;
+    }
+
+}  // namespace l3_slice_map
+
+// Each line is assigned to the slice next to the physical core that reaches it fastest, named by the core's first
+// CPU. For every CPU, the rows give the median
+// latency of the lines in each such slice: a distance map from CPUs to slices.
+int main()
+{
+    constexpr auto RAND_SEED = std::uint64_t{12345};
+
+    l3_slice_map::print_csv_header();
+
+    try
+    {
+        const auto cpus = common::get_available_cpus();
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+        const auto geometry = l3_slice_map::get_l2_geometry();
+
+        // Hugepages make the physical set index bits equal to the virtual ones. THP may silently fall back to base
+        // pages, so the buffer comes from the hugetlb pool and the run fails if that is empty.
+        const auto lines_per_set = geometry.num_ways + (geometry.num_ways / 2);
+        const auto buffer =
+            common::MemoryBuffer(lines_per_set * geometry.bytes_per_way, common::MemoryBackend::Hugetlb2M);
+        if (geometry.bytes_per_way > buffer.page_size())
+        {
+            throw std::runtime_error("The L2 way size exceeds the hugepage size.");
+        }
+
+        auto* const buffer_ptr = buffer.data<unsigned char>();
+        const auto num_sets = std::min(l3_slice_map::NUM_SETS, geometry.bytes_per_way / cache_line_bytes);
+        auto chains = std::vector<l3_slice_map::ChainInfo>();
+        for (std::size_t set = 0; set < num_sets; ++set)
+        {
+            const auto lines = l3_slice_map::get_set_lines(buffer_ptr, geometry, cache_line_bytes, set, lines_per_set);
+            auto* const start_ptr = common::link_random_pointer_chasing(lines, RAND_SEED + set);
+            chains.push_back({start_ptr, l3_slice_map::get_chain_order(start_ptr, lines.size())});
+        }
+
+        common::pin_current_thread_to_cpu(cpus.front());
+        const auto timer_overhead = l3_slice_map::measure_timer_overhead();
+
+        // latencies[i][j]: latency of line `j` from `cpus[i]`
+        auto latencies = std::vector<std::vector<std::uint64_t>>();
+        for (const auto cpu : cpus)
+        {
+            common::pin_current_thread_to_cpu(cpu);
+            latencies.push_back(l3_slice_map::measure_line_latencies(chains, timer_overhead));
+        }
+
+        // SMT siblings share a slice, so lines are assigned to physical cores; a core reaches a line as fast as its
+        // fastest sibling
+        const auto cores = l3_slice_map::get_physical_cores(cpus);
+        const auto num_lines = latencies.front().size();
+        auto nearest = std::vector<std::size_t>(num_lines, 0);
+        for (std::size_t line = 0; line < num_lines; ++line)
+        {
+            auto nearest_latency = std::numeric_limits<std::uint64_t>::max();
+            for (std::size_t core = 0; core < cores.size(); ++core)
+            {
+                for (const auto i : cores[core])
+                {
+                    if (latencies[i][line] < nearest_latency)
+                    {
+                        nearest_latency = latencies[i][line];
+                        nearest[line] = core;
+                    }
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < cpus.size(); ++i)
+        {
+            for (std::size_t slice = 0; slice < cores.size(); ++slice)
+            {
+                auto group = std::vector<std::uint64_t>();
+                for (std::size_t line = 0; line < num_lines; ++line)
+                {
+                    if (nearest[line] == slice)
+                    {
+                        group.push_back(latencies[i][line]);
+                    }
+                }
+
+                if (!group.empty())
+                {
+                    l3_slice_map::print_csv_row(
+                        {cpus[i], cpus[cores[slice].front()], group.size(), l3_slice_map::get_median(group)});
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "common.hpp"
+#include "pointer_chasing.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace l3_slice_map
+{
+    struct L2Geometry
+    {
+        std::size_t num_ways;
+        // Distance between consecutive lines that map to the same set
+        std::size_t bytes_per_way;
+    };
+
+    [[nodiscard]] inline L2Geometry get_l2_geometry()
+    {
+        const auto size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        const auto ways = sysconf(_SC_LEVEL2_CACHE_ASSOC);
+        if (size < 1 || ways < 1)
+        {
+            throw std::runtime_error("Failed to get the L2 cache geometry.");
+        }
+        return {static_cast<std::size_t>(ways), static_cast<std::size_t>(size / ways)};
+    }
+
+    // Lines `set_index` lines into each way-sized stride of the buffer. They share one L1 and L2 set, so a chain over
+    // more of them than the L2 has ways misses both levels on every step, while their few lines stay in the L3.
+    [[nodiscard]] inline std::vector<common::MemoryAddress*> get_set_lines(unsigned char* const buffer,
+                                                                           const L2Geometry& geometry,
+                                                                           const std::size_t line_size,
+                                                                           const std::size_t set_index,
+                                                                           const std::size_t num_lines)
+    {
+        auto lines = std::vector<common::MemoryAddress*>();
+        for (std::size_t i = 0; i < num_lines; ++i)
+        {
+            auto* const line = buffer + (i * geometry.bytes_per_way) + (set_index * line_size);
+            lines.push_back(reinterpret_cast<common::MemoryAddress*>(line));
+        }
+        return lines;
+    }
+
+    // Elements in the order a chase from `start_ptr` loads them
+    [[nodiscard]] inline std::vector<common::MemoryAddress*> get_chain_order(common::MemoryAddress* const start_ptr,
+                                                                             const std::size_t num_elements)
+    {
+        auto order = std::vector<common::MemoryAddress*>();
+        auto* current_ptr = start_ptr;
+        for (std::size_t i = 0; i < num_elements; ++i)
+        {
+            order.push_back(current_ptr);
+            current_ptr = static_cast<common::MemoryAddress*>(*current_ptr);
+        }
+        return order;
+    }
+
+    // Indices into `cpus` grouped by physical core, in order of each core's first CPU
+    [[nodiscard]] inline std::vector<std::vector<std::size_t>> get_physical_cores(const std::vector<std::int32_t>& cpus)
+    {
+        auto cores = std::vector<std::vector<std::size_t>>();
+        auto core_locations = std::vector<common::CpuLocation>();
+        for (std::size_t i = 0; i < cpus.size(); ++i)
+        {
+            const auto location = common::get_cpu_location(cpus[i]);
+            const auto is_same_core = [&location](const common::CpuLocation& other) {
+                return common::get_cpu_relation(location, other) == common::CpuRelation::SmtSibling;
+            };
+
+            const auto it = std::find_if(core_locations.begin(), core_locations.end(), is_same_core);
+            if (it == core_locations.end())
+            {
+                core_locations.push_back(location);
+                cores.push_back({i});
+            }
+            else
+            {
+                cores[static_cast<std::size_t>(it - core_locations.begin())].push_back(i);
+            }
+        }
+        return cores;
+    }
+
+    [[nodiscard]] inline std::uint64_t get_median(std::vector<std::uint64_t>& values)
+    {
+        const auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+        std::nth_element(values.begin(), middle, values.end());
+        return *middle;
+    }
+
+    // Median latency in TSC ticks of each load position over the laps of a sampled chase, with `timer_overhead`
+    // removed. `timestamps` holds `num_laps * num_elements + 1` entries from `walk_pointer_chain_sampled<1>`.
+    [[nodiscard]] inline std::vector<std::uint64_t> get_position_latencies(const std::vector<std::uint64_t>& timestamps,
+                                                                           const std::size_t num_elements,
+                                                                           const std::uint64_t timer_overhead)
+    {
+        const auto num_laps = (timestamps.size() - 1) / num_elements;
+
+        auto latencies = std::vector<std::uint64_t>(num_elements);
+        auto samples = std::vector<std::uint64_t>(num_laps);
+        for (std::size_t position = 0; position < num_elements; ++position)
+        {
+            for (std::size_t lap = 0; lap < num_laps; ++lap)
+            {
+                const auto index = (lap * num_elements) + position;
+                const auto interval = timestamps[index + 1] - timestamps[index];
+                samples[lap] = interval > timer_overhead ? interval - timer_overhead : 0;
+            }
+            latencies[position] = get_median(samples);
+        }
+        return latencies;
+    }
+
+}  // namespace l3_slice_map
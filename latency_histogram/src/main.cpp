@@ -0,0 +1,138 @@
+#include "common.hpp"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+namespace latency_histogram
+{
+    constexpr auto NUM_SAMPLES = std::size_t{100'000};
+
+    using SampledKernel = common::MemoryAddress* (*)(common::MemoryAddress*, std::uint64_t*, std::size_t);
+
+    struct SampledKernelInfo
+    {
+        std::int32_t sample_interval;
+        SampledKernel kernel;
+    };
+
+    // An interval of 1 times every load on its own; longer intervals amortize the timestamp read over more loads
+    constexpr SampledKernelInfo SAMPLED_KERNELS[] = {
+        {1, common::walk_pointer_chain_sampled<1>},
+        {16, common::walk_pointer_chain_sampled<16>},
+    };
+
+    struct BenchmarkConfig
+    {
+        const common::MemoryBackend backend;
+        const std::size_t buffer_size;
+        const std::size_t padded_element_size;
+        const std::size_t page_size;
+        const std::int32_t sample_interval;
+        const std::uint64_t timer_overhead;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,BufferSize,PaddedElementSize,PageSize,SampleInterval,NumSamples,"
+                     "TimerOverheadTscTicks,LatencyTscTicks,Count\n";
+    }
+
+    // One row per non-empty bin
+    void print_csv_rows(const BenchmarkConfig& config, const Histogram& histogram)
+    {
+        for (std::size_t latency = 0; latency < histogram.counts.size(); ++latency)
+        {
+            if (histogram.counts[latency] == 0)
+            {
+                continue;
+            }
+
+            std::cout << to_string(config.backend) << "," << config.buffer_size << "," << config.padded_element_size
+                      << "," << config.page_size << "," << config.sample_interval << "," << NUM_SAMPLES << ","
+                      << config.timer_overhead << "," << latency << "," << histogram.counts[latency] << "\n";
+        }
+    }
+
+    // Samples without any loads in between
+    [[nodiscard]] std::uint64_t measure_timer_overhead(std::vector<std::uint64_t>& timestamps)
+    {
+        auto* volatile kernel = common::walk_pointer_chain_sampled<0>;
+        kernel(nullptr, timestamps.data(), NUM_SAMPLES);
+        return get_min_interval(timestamps);
+    }
+
+    void run_benchmark(const common::MemoryBackend backend, const std::size_t buffer_size_in_bytes,
+                       const std::size_t padded_bytes_per_element, const std::uint64_t timer_overhead,
+                       std::vector<std::uint64_t>& timestamps)
+    {
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+        constexpr auto RAND_SEED = std::uint64_t{12345};
+
+        if (buffer_size_in_bytes % padded_bytes_per_element != 0)
+        {
+            std::cerr << "Error: `buffer_size_in_bytes` must be a multiple of `padded_bytes_per_element`\n";
+            return;
+        }
+        const auto num_elements = buffer_size_in_bytes / padded_bytes_per_element;
+        const auto buffer = common::MemoryBuffer(buffer_size_in_bytes, backend);
+
+        auto* const start_ptr = common::generate_random_pointer_chasing(
+            buffer.data<common::MemoryAddress>(), num_elements, padded_bytes_per_element, RAND_SEED);
+
+        for (const auto& info : SAMPLED_KERNELS)
+        {
+            auto* volatile kernel = info.kernel;
+
+            // Only the last run is kept: the distribution is the result, so no run is preferred over another
+            for (std::int32_t i = 0; i <= NUM_WARMUPS; ++i)
+            {
+                kernel(start_ptr, timestamps.data(), NUM_SAMPLES);
+            }
+
+            const auto config = BenchmarkConfig{backend, buffer_size_in_bytes, padded_bytes_per_element,
+                                                buffer.page_size(), info.sample_interval, timer_overhead};
+            print_csv_rows(config, build_histogram(timestamps, info.sample_interval, timer_overhead));
+        }
+    }
+
+}  // namespace latency_histogram
+
+int main()
+{
+    latency_histogram::print_csv_header();
+
+    try
+    {
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+        const auto page_size = common::get_page_size();
+        const auto backends =
+            common::get_memory_backends({common::MemoryBackend::Thp, common::MemoryBackend::Anonymous});
+
+        // Stay on one CPU so that every timestamp comes from the same TSC
+        common::pin_current_thread_to_cpu(common::get_available_cpus().front());
+
+        auto timestamps = std::vector<std::uint64_t>(latency_histogram::NUM_SAMPLES + 1);
+        const auto timer_overhead = latency_histogram::measure_timer_overhead(timestamps);
+
+        for (const auto backend : backends)
+        {
+            for (auto size = 16 * common::KiB; size <= 1 * common::GiB; size *= 2)  // NOLINT(readability-magic-numbers)
+            {
+                latency_histogram::run_benchmark(backend, size, cache_line_bytes, timer_overhead, timestamps);
+                latency_histogram::run_benchmark(backend, size, page_size, timer_overhead, timestamps);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace latency_histogram
+{
+    // Per-load latencies of this many TSC ticks or more share the last bin
+    constexpr auto MAX_LATENCY_TICKS = std::uint64_t{4096};
+
+    // `counts[t]` is the number of samples whose per-load latency rounds to `t` ticks
+    struct Histogram
+    {
+        std::vector<std::uint64_t> counts = std::vector<std::uint64_t>(MAX_LATENCY_TICKS + 1, 0);
+    };
+
+    // Smallest gap between consecutive timestamps, i.e. the cost of the timestamp read itself
+    [[nodiscard]] inline std::uint64_t get_min_interval(const std::vector<std::uint64_t>& timestamps) noexcept
+    {
+        auto min_interval = std::numeric_limits<std::uint64_t>::max();
+        for (std::size_t i = 1; i < timestamps.size(); ++i)
+        {
+            min_interval = std::min(min_interval, timestamps[i] - timestamps[i - 1]);
+        }
+        return min_interval;
+    }
+
+    // Each interval covers `sample_interval` dependent loads plus one timestamp read of `timer_overhead` ticks
+    [[nodiscard]] inline Histogram build_histogram(const std::vector<std::uint64_t>& timestamps,
+                                                   const std::int32_t sample_interval,
+                                                   const std::uint64_t timer_overhead)
+    {
+        const auto num_loads = static_cast<std::uint64_t>(sample_interval);
+
+        auto histogram = Histogram{};
+        for (std::size_t i = 1; i < timestamps.size(); ++i)
+        {
+            const auto interval = timestamps[i] - timestamps[i - 1];
+            const auto load_ticks = interval > timer_overhead ? interval - timer_overhead : 0;
+            const auto latency = (load_ticks + (num_loads / 2)) / num_loads;
+            ++histogram.counts[std::min(latency, MAX_LATENCY_TICKS)];
+        }
+        return histogram;
+    }
+
+}  // namespace latency_histogram
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <immintrin.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+// Every lock is constructed with the number of threads that will use it, and each thread passes its own context
+// (from `make_context`) to `lock` and `unlock`. Queue locks keep their nodes in the lock so that a node can outlive the
+// thread that enqueued it.
+namespace lock_scalability
+{
+    constexpr auto CACHE_LINE_SIZE = std::size_t{64};
+
+    struct EmptyContext
+    {
+    };
+
+    class TasLock
+    {
+    public:
+        static constexpr auto NAME = "TAS";
+        static constexpr auto IS_EXCLUSIVE = true;
+        using Context = EmptyContext;
+
+        explicit TasLock(const std::size_t /*num_threads*/) {}
+
+        [[nodiscard]] Context make_context(const std::size_t /*thread_index*/) const noexcept { return {}; }
+
+        void lock(Context& /*context*/) noexcept
+        {
+            while (locked_.exchange(true, std::memory_order_acquire))
+            {
+                _mm_pause();
+            }
+        }
+
+        void unlock(Context& /*context*/) noexcept { locked_.store(false, std::memory_order_release); }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> locked_{false};
+    };
+
+    class TtasLock
+    {
+    public:
+        static constexpr auto NAME = "TTAS";
+        static constexpr auto IS_EXCLUSIVE = true;
+        using Context = EmptyContext;
+
+        explicit TtasLock(const std::size_t /*num_threads*/) {}
+
+        [[nodiscard]] Context make_context(const std::size_t /*thread_index*/) const noexcept { return {}; }
+
+        void lock(Context& /*context*/) noexcept
+        {
+            while (locked_.exchange(true, std::memory_order_acquire))
+            {
+                while (locked_.load(std::memory_order_relaxed))
+                {
+                    _mm_pause();
+                }
+            }
+        }
+
+        void unlock(Context& /*context*/) noexcept { locked_.store(false, std::memory_order_release); }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<bool> locked_{false};
+    };
+
+    class TicketLock
+    {
+    public:
+        static constexpr auto NAME = "Ticket";
+        static constexpr auto IS_EXCLUSIVE = true;
+        using Context = EmptyContext;
+
+        explicit TicketLock(const std::size_t /*num_threads*/) {}
+
+        [[nodiscard]] Context make_context(const std::size_t /*thread_index*/) const noexcept { return {}; }
+
+        void lock(Context& /*context*/) noexcept
+        {
+            const auto ticket = next_ticket_.fetch_add(1, std::memory_order_relaxed);
+            while (now_serving_.load(std::memory_order_acquire) != ticket)
+            {
+                _mm_pause();
+            }
+        }
+
+        void unlock(Context& /*context*/) noexcept
+        {
+            now_serving_.store(now_serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> next_ticket_{0};
+        std::atomic<std::uint32_t> now_serving_{0};
+    };
+
+    // Mellor-Crummey and Scott: each waiter spins on its own node, and the releasing thread hands over to its successor
+    class McsLock
+    {
+    public:
+        static constexpr auto NAME = "MCS";
+        static constexpr auto IS_EXCLUSIVE = true;
+
+        struct alignas(CACHE_LINE_SIZE) Node
+        {
+            std::atomic<Node*> next{nullptr};
+            std::atomic<bool> locked{false};
+        };
+
+        struct Context
+        {
+            Node* node;
+        };
+
+        explicit McsLock(const std::size_t num_threads) : nodes_(num_threads) {}
+
+        [[nodiscard]] Context make_context(const std::size_t thread_index) noexcept
+        {
+            return {&nodes_[thread_index]};
+        }
+
+        void lock(Context& context) noexcept
+        {
+            auto* const node = context.node;
+            node->next.store(nullptr, std::memory_order_relaxed);
+            node->locked.store(true, std::memory_order_relaxed);
+
+            auto* const predecessor = tail_.exchange(node, std::memory_order_acq_rel);
+            if (predecessor == nullptr)
+            {
+                return;
+            }
+
+            predecessor->next.store(node, std::memory_order_release);
+            while (node->locked.load(std::memory_order_acquire))
+            {
+                _mm_pause();
+            }
+        }
+
+        void unlock(Context& context) noexcept
+        {
+            auto* const node = context.node;
+            auto* successor = node->next.load(std::memory_order_acquire);
+            if (successor == nullptr)
+            {
+                auto* expected = node;
+                if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release,
+                                                  std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                // A successor has swapped the tail but not linked itself yet
+                while ((successor = node->next.load(std::memory_order_acquire)) == nullptr)
+                {
+                    _mm_pause();
+                }
+            }
+            successor->locked.store(false, std::memory_order_release);
+        }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> tail_{nullptr};
+        std::vector<Node> nodes_;
+    };
+
+    // Craig, Landin and Hagersten: each waiter spins on its predecessor's node and recycles it after the release
+    class ClhLock
+    {
+    public:
+        static constexpr auto NAME = "CLH";
+        static constexpr auto IS_EXCLUSIVE = true;
+
+        struct alignas(CACHE_LINE_SIZE) Node
+        {
+            std::atomic<bool> locked{false};
+        };
+
+        struct Context
+        {
+            Node* node;
+            Node* predecessor;
+        };
+
+        // The extra node is the initial, unlocked tail
+        explicit ClhLock(const std::size_t num_threads) : nodes_(num_threads + 1), tail_(&nodes_[num_threads]) {}
+
+        [[nodiscard]] Context make_context(const std::size_t thread_index) noexcept
+        {
+            return {&nodes_[thread_index], nullptr};
+        }
+
+        void lock(Context& context) noexcept
+        {
+            context.node->locked.store(true, std::memory_order_relaxed);
+            context.predecessor = tail_.exchange(context.node, std::memory_order_acq_rel);
+            while (context.predecessor->locked.load(std::memory_order_acquire))
+            {
+                _mm_pause();
+            }
+        }
+
+        void unlock(Context& context) noexcept
+        {
+            auto* const released = context.node;
+            context.node = context.predecessor;
+            released->locked.store(false, std::memory_order_release);
+        }
+
+    private:
+        std::vector<Node> nodes_;
+        alignas(CACHE_LINE_SIZE) std::atomic<Node*> tail_;
+    };
+
+    // Three-state futex mutex (0: unlocked, 1: locked, 2: locked with waiters) from Drepper's "Futexes Are Tricky"
+    class FutexLock
+    {
+    public:
+        static constexpr auto NAME = "Futex";
+        static constexpr auto IS_EXCLUSIVE = true;
+        using Context = EmptyContext;
+
+        explicit FutexLock(const std::size_t /*num_threads*/) {}
+
+        [[nodiscard]] Context make_context(const std::size_t /*thread_index*/) const noexcept { return {}; }
+
+        void lock(Context& /*context*/) noexcept
+        {
+            auto state = std::uint32_t{0};
+            if (state_.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            if (state != 2)
+            {
+                state = state_.exchange(2, std::memory_order_acquire);
+            }
+            while (state != 0)
+            {
+                futex(FUTEX_WAIT_PRIVATE, 2);
+                state = state_.exchange(2, std::memory_order_acquire);
+            }
+        }
+
+        void unlock(Context& /*context*/) noexcept
+        {
+            if (state_.fetch_sub(1, std::memory_order_release) != 1)
+            {
+                state_.store(0, std::memory_order_release);
+                futex(FUTEX_WAKE_PRIVATE, 1);
+            }
+        }
+
+    private:
+        static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) &&
+                          std::atomic<std::uint32_t>::is_always_lock_free,
+                      "The futex word must be a plain 32-bit integer.");
+
+        void futex(const int operation, const std::uint32_t value) noexcept
+        {
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state_), operation, value, nullptr, nullptr, 0);
+        }
+
+        alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> state_{0};
+    };
+
+    class StdMutexLock
+    {
+    public:
+        static constexpr auto NAME = "StdMutex";
+        static constexpr auto IS_EXCLUSIVE = true;
+        using Context = EmptyContext;
+
+        explicit StdMutexLock(const std::size_t /*num_threads*/) {}
+
+        [[nodiscard]] Context make_context(const std::size_t /*thread_index*/) const noexcept { return {}; }
+
+        void lock(Context& /*context*/) { mutex_.lock(); }
+        void unlock(Context& /*context*/) { mutex_.unlock(); }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::mutex mutex_;
+    };
+
+    class StdSharedMutexExclusiveLock
+    {
+    public:
+        static constexpr auto NAME = "StdSharedMutexExclusive";
+        static constexpr auto IS_EXCLUSIVE = true;
+        using Context = EmptyContext;
+
+        explicit StdSharedMutexExclusiveLock(const std::size_t /*num_threads*/) {}
+
+        [[nodiscard]] Context make_context(const std::size_t /*thread_index*/) const noexcept { return {}; }
+
+        void lock(Context& /*context*/) { mutex_.lock(); }
+        void unlock(Context& /*context*/) { mutex_.unlock(); }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::shared_mutex mutex_;
+    };
+
+    // Read-side acquisitions only; critical sections may overlap
+    class StdSharedMutexSharedLock
+    {
+    public:
+        static constexpr auto NAME = "StdSharedMutexShared";
+        static constexpr auto IS_EXCLUSIVE = false;
+        using Context = EmptyContext;
+
+        explicit StdSharedMutexSharedLock(const std::size_t /*num_threads*/) {}
+
+        [[nodiscard]] Context make_context(const std::size_t /*thread_index*/) const noexcept { return {}; }
+
+        void lock(Context& /*context*/) { mutex_.lock_shared(); }
+        void unlock(Context& /*context*/) { mutex_.unlock_shared(); }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::shared_mutex mutex_;
+    };
+
+}  // namespace lock_scalability
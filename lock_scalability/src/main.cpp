@@ -0,0 +1,229 @@
+#include "common.hpp"
+#include "locks.hpp"
+#include "utils.hpp"
+
+#include <x86intrin.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace lock_scalability
+{
+    constexpr auto NO_OWNER = static_cast<std::size_t>(-1);
+
+    // Spin-work units inside and outside the critical section
+    struct WorkConfig
+    {
+        std::int32_t critical_section_work;
+        std::int32_t non_critical_section_work;
+    };
+
+    constexpr auto WORK_CONFIGS = std::array<WorkConfig, 4>{{{0, 0}, {0, 1000}, {100, 0}, {100, 1000}}};
+
+    // Written only while the lock is held exclusively
+    struct alignas(CACHE_LINE_SIZE) SharedState
+    {
+        std::uint64_t counter = 0;
+        std::size_t last_owner = NO_OWNER;
+        std::uint64_t last_release_tsc = 0;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ThreadStats
+    {
+        std::uint64_t acquisitions = 0;
+        std::uint64_t handoffs = 0;
+        std::uint64_t handoff_tsc_ticks = 0;
+    };
+
+    struct BenchmarkResult
+    {
+        const char* const lock_name;
+        const std::size_t num_threads;
+        const std::int32_t critical_section_work;
+        const std::int32_t non_critical_section_work;
+        std::int64_t elapsed_ns = 0;
+        std::uint64_t acquisitions = 0;
+        double fairness_index = 0.0;
+        std::uint64_t handoffs = 0;
+        std::uint64_t handoff_tsc_ticks = 0;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Lock,Threads,CriticalSectionWork,NonCriticalSectionWork,Nanoseconds,Acquisitions,FairnessIndex,"
+                     "Handoffs,HandoffTscTicks\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << result.lock_name << "," << result.num_threads << "," << result.critical_section_work << ","
+                  << result.non_critical_section_work << "," << result.elapsed_ns << "," << result.acquisitions << ","
+                  << result.fairness_index << "," << result.handoffs << "," << result.handoff_tsc_ticks << "\n";
+    }
+
+    // A handoff is an acquisition by a different thread than the previous owner; its latency runs from the TSC stamp
+    // taken just before the previous owner's unlock to the TSC read right after the new owner's lock.
+    template <typename Lock>
+    void run_lock_thread(Lock& lock, SharedState& shared, ThreadStats& stats, const std::size_t thread_index,
+                         const std::int32_t critical_section_work, const std::int32_t non_critical_section_work,
+                         const std::atomic<bool>& stop_flag, std::atomic<bool>& started_flag)
+    {
+        auto context = lock.make_context(thread_index);
+        started_flag.store(true, std::memory_order_relaxed);
+
+        while (!stop_flag.load(std::memory_order_relaxed))
+        {
+            lock.lock(context);
+
+            if constexpr (Lock::IS_EXCLUSIVE)
+            {
+                const auto acquire_tsc = __rdtsc();
+                if (shared.last_owner != thread_index && shared.last_owner != NO_OWNER)
+                {
+                    ++stats.handoffs;
+                    stats.handoff_tsc_ticks += acquire_tsc - shared.last_release_tsc;
+                }
+
+                ++shared.counter;
+                spin_work(critical_section_work);
+
+                shared.last_owner = thread_index;
+                shared.last_release_tsc = __rdtsc();
+            }
+            else
+            {
+                static_cast<void>(*static_cast<volatile std::uint64_t*>(&shared.counter));
+                spin_work(critical_section_work);
+            }
+
+            lock.unlock(context);
+
+            ++stats.acquisitions;
+            spin_work(non_critical_section_work);
+        }
+    }
+
+    template <typename Lock>
+    void run_benchmark(const std::vector<std::int32_t>& cpus, const std::int32_t critical_section_work,
+                       const std::int32_t non_critical_section_work)
+    {
+        constexpr auto DURATION = std::chrono::milliseconds{200};
+        constexpr auto NUM_TRIALS = std::int32_t{3};
+
+        auto best = std::optional<BenchmarkResult>();
+        auto best_throughput = 0.0;
+
+        for (std::int32_t i = 0; i < NUM_TRIALS; ++i)
+        {
+            auto lock = Lock(cpus.size());
+            auto shared = SharedState{};
+            auto stats = std::vector<ThreadStats>(cpus.size());
+            auto stop_flag = std::atomic<bool>{false};
+            auto started_flag = std::atomic<bool>{false};
+
+            // Stops the run a fixed time after the first thread has started
+            auto timer = std::thread([&]() {
+                while (!started_flag.load(std::memory_order_relaxed))
+                {
+                    std::this_thread::yield();
+                }
+                std::this_thread::sleep_for(DURATION);
+                stop_flag.store(true, std::memory_order_relaxed);
+            });
+
+            auto elapsed_ns = std::int64_t{0};
+            try
+            {
+                elapsed_ns = common::run_pinned_threads(cpus, [&](const std::size_t thread_index) {
+                    run_lock_thread(lock, shared, stats[thread_index], thread_index, critical_section_work,
+                                    non_critical_section_work, stop_flag, started_flag);
+                });
+            }
+            catch (...)
+            {
+                started_flag.store(true, std::memory_order_relaxed);
+                timer.join();
+                throw;
+            }
+            timer.join();
+
+            auto result = BenchmarkResult{Lock::NAME, cpus.size(), critical_section_work, non_critical_section_work};
+            result.elapsed_ns = elapsed_ns;
+
+            auto counts = std::vector<std::uint64_t>();
+            for (const auto& thread_stats : stats)
+            {
+                counts.push_back(thread_stats.acquisitions);
+                result.acquisitions += thread_stats.acquisitions;
+                result.handoffs += thread_stats.handoffs;
+                result.handoff_tsc_ticks += thread_stats.handoff_tsc_ticks;
+            }
+            result.fairness_index = compute_fairness_index(counts);
+
+            if (Lock::IS_EXCLUSIVE && shared.counter != result.acquisitions)
+            {
+                std::cerr << "Error: Lock '" << Lock::NAME << "' did not provide mutual exclusion.\n";
+                return;
+            }
+
+            const auto throughput = static_cast<double>(result.acquisitions) / static_cast<double>(elapsed_ns);
+            if (!best.has_value() || throughput > best_throughput)
+            {
+                best_throughput = throughput;
+                best.emplace(result);
+            }
+        }
+
+        print_csv_row(*best);
+    }
+
+    template <typename... Locks>
+    void run_benchmarks(const std::vector<std::int32_t>& cpus, const std::int32_t critical_section_work,
+                        const std::int32_t non_critical_section_work)
+    {
+        (run_benchmark<Locks>(cpus, critical_section_work, non_critical_section_work), ...);
+    }
+
+}  // namespace lock_scalability
+
+int main()
+{
+    lock_scalability::print_csv_header();
+
+    try
+    {
+        const auto cpus = common::get_available_cpus();
+
+        auto thread_cpu_sets = std::vector<std::vector<std::int32_t>>();
+        for (std::size_t num_threads = 1; num_threads < cpus.size(); num_threads *= 2)
+        {
+            thread_cpu_sets.emplace_back(cpus.begin(), cpus.begin() + static_cast<std::ptrdiff_t>(num_threads));
+        }
+        thread_cpu_sets.push_back(cpus);
+
+        for (const auto& config : lock_scalability::WORK_CONFIGS)
+        {
+            for (const auto& thread_cpus : thread_cpu_sets)
+            {
+                using namespace lock_scalability;
+                run_benchmarks<TasLock, TtasLock, TicketLock, McsLock, ClhLock, FutexLock, StdMutexLock,
+                               StdSharedMutexExclusiveLock, StdSharedMutexSharedLock>(
+                    thread_cpus, config.critical_section_work, config.non_critical_section_work);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
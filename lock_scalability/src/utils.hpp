@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lock_scalability
+{
+    // Burns roughly one cycle per unit with a dependent chain of register additions
+    inline void spin_work(const std::int32_t units) noexcept
+    {
+        auto value = std::uint64_t{0};
+        for (std::int32_t i = 0; i < units; ++i)
+        {
+            __asm__ volatile("add $1, %0" : "+r"(value));
+        }
+    }
+
+    // Jain's fairness index: 1 when all threads acquired the lock equally often, 1/N when a single thread did
+    [[nodiscard]] inline double compute_fairness_index(const std::vector<std::uint64_t>& counts) noexcept
+    {
+        auto sum = 0.0;
+        auto sum_of_squares = 0.0;
+        for (const auto count : counts)
+        {
+            sum += static_cast<double>(count);
+            sum_of_squares += static_cast<double>(count) * static_cast<double>(count);
+        }
+
+        if (sum_of_squares == 0.0)
+        {
+            return 0.0;
+        }
+        return (sum * sum) / (static_cast<double>(counts.size()) * sum_of_squares);
+    }
+
+}  // namespace lock_scalability
@@ -12,6 +12,18 @@ def format_bytes(bytes):
 def load_benchmark_data(filename):
     df = pd.read_csv(filename)
 
+    # Results from before the offset sweep only contain aligned pointers
+    if "ElementOffset" not in df.columns:
+        df["ElementOffset"] = 0
+
+    # Results from before the antagonist profiles were all taken without one
+    if "Antagonist" not in df.columns:
+        df["Antagonist"] = "None"
+
+    # Results from before the memory backends chose hugepages or base pages by page size alone
+    if "MemoryBackend" not in df.columns:
+        df["MemoryBackend"] = np.where(df["PageSize"] == 4096, "Anonymous", "Thp")
+
     num_loads = df["NumLogicalLoads"]
 
     df["Latency"] = df["Cycles"] / num_loads
@@ -32,6 +44,8 @@ def print_table(title, df, columns, labels):
         "PageSize": format_bytes,
         "PageEntries": "{:.0f}".format,
         "Latency": "{:.2f}".format,
+        "AlignedLatency": "{:.2f}".format,
+        "SplitPenalty": "{:.2f}".format,
         "L1DMissRate": "{:.2f}".format,
         "L2MissRate": "{:.2f}".format,
         "L3MissRate": "{:.2f}".format,
@@ -52,17 +66,18 @@ def print_table(title, df, columns, labels):
 
 
 def print_cache_latency_table(df):
-    subset = df[df["PaddedElementSize"] == 64].copy()
+    subset = df[(df["PaddedElementSize"] == 64) & (df["ElementOffset"] == 0)].copy()
 
     if subset.empty:
         return
 
-    subset = subset.sort_values(by="BufferSize", ascending=True)
+    subset = subset.sort_values(by=["BufferSize", "MemoryBackend"], ascending=True)
 
     title = "Cache Hierarchy Analysis (PaddedElementSize: 64 Bytes)"
-    cols = ["BufferSize", "Latency", "L1DMissRate", "L2MissRate", "L3MissRate", "TLBMissRate"]
+    cols = ["BufferSize", "MemoryBackend", "Latency", "L1DMissRate", "L2MissRate", "L3MissRate", "TLBMissRate"]
     headers = [
         "BufferSize",
+        "MemoryBackend",
         "Latency (cycles)",
         "L1DMiss (%)",
         "L2Miss (%)",
@@ -74,16 +89,17 @@ def print_cache_latency_table(df):
 
 
 def print_tlb_latency_table(df):
-    subset = df[df["PaddedElementSize"] == 4096].copy()
+    subset = df[(df["PaddedElementSize"] == 4096) & (df["ElementOffset"] == 0)].copy()
 
     if subset.empty:
         return
 
-    subset = subset.sort_values(by=["BufferSize", "PageSize"], ascending=[True, False])
+    subset = subset.sort_values(by=["BufferSize", "PageSize", "MemoryBackend"], ascending=[True, False, True])
 
     title = "TLB Analysis (PaddedElementSize: 4096 Bytes)"
     cols = [
         "BufferSize",
+        "MemoryBackend",
         "PageSize",
         "PageEntries",
         "Latency",
@@ -94,6 +110,7 @@ def print_tlb_latency_table(df):
     ]
     headers = [
         "BufferSize",
+        "MemoryBackend",
         "PageSize",
         "PageEntries",
         "Latency (cycles)",
@@ -106,14 +123,87 @@ def print_tlb_latency_table(df):
     print_table(title, subset, cols, headers)
 
 
+def print_split_latency_table(df, padded_element_size, boundary):
+    keys = ["BufferSize", "PaddedElementSize", "MemoryBackend"]
+    aligned = df[(df["PaddedElementSize"] == padded_element_size) & (df["ElementOffset"] == 0)]
+    split = df[(df["PaddedElementSize"] == padded_element_size) & (df["ElementOffset"] != 0)]
+
+    subset = split.merge(
+        aligned[keys + ["Latency"]].rename(columns={"Latency": "AlignedLatency"}),
+        on=keys,
+    )
+
+    if subset.empty:
+        return
+
+    subset["SplitPenalty"] = subset["Latency"] - subset["AlignedLatency"]
+    subset = subset.sort_values(by=["BufferSize", "MemoryBackend"], ascending=True)
+
+    title = f"{boundary} Split Analysis (PaddedElementSize: {padded_element_size} Bytes)"
+    cols = [
+        "BufferSize",
+        "MemoryBackend",
+        "ElementOffset",
+        "AlignedLatency",
+        "Latency",
+        "SplitPenalty",
+        "L1DMissRate",
+        "TLBMissRate",
+    ]
+    headers = [
+        "BufferSize",
+        "MemoryBackend",
+        "ElementOffset",
+        "Aligned (cycles)",
+        "Split (cycles)",
+        "Penalty (cycles)",
+        "L1DMiss (%)",
+        "TLBMiss (%)",
+    ]
+
+    print_table(title, subset, cols, headers)
+
+
+def print_antagonist_table(df):
+    subset = df[(df["PaddedElementSize"] == 64) & (df["ElementOffset"] == 0)]
+
+    if subset["Antagonist"].nunique() < 2:
+        return
+
+    pivot = subset.pivot_table(
+        index=["BufferSize", "MemoryBackend"], columns="Antagonist", values="Latency", sort=False
+    )
+    pivot = pivot.sort_index()
+    pivot.index = pivot.index.map(lambda key: (format_bytes(key[0]), key[1]))
+
+    title = "Antagonist Analysis (PaddedElementSize: 64 Bytes, Latency in cycles)"
+    table = pivot.to_string(float_format="{:.2f}".format)
+
+    print(title)
+    print("=" * len(table.split("\n")[0]))
+    print(table)
+    print("\n")
+
+
 def main():
     parser = argparse.ArgumentParser(description="Analyze memory benchmark results.")
     parser.add_argument("filename", help="Path to the CSV file")
     args = parser.parse_args()
 
     df = load_benchmark_data(args.filename)
-    print_cache_latency_table(df)
-    print_tlb_latency_table(df)
+    antagonists = df["Antagonist"].unique()
+
+    for antagonist in antagonists:
+        subset = df[df["Antagonist"] == antagonist]
+        if len(antagonists) > 1:
+            print(f"Antagonist: {antagonist}\n")
+
+        print_cache_latency_table(subset)
+        print_tlb_latency_table(subset)
+        print_split_latency_table(subset, 64, "Cache Line")
+        print_split_latency_table(subset, 4096, "Page")
+
+    print_antagonist_table(df)
 
 
 if __name__ == "__main__":
@@ -1,14 +1,15 @@
+#include "antagonist.hpp"
 #include "common.hpp"
 #include "perf_counter.h"
-#include "utils.hpp"
+#include "pointer_chasing.hpp"
 
-#include <sys/mman.h>
 #include <cstddef>
 #include <cstdint>
-#include <cstring>
 #include <exception>
 #include <iostream>
 #include <limits>
+#include <string>
+#include <vector>
 
 namespace memory_latency
 {
@@ -40,8 +41,11 @@ namespace memory_latency
 
     struct BenchmarkResult
     {
+        const std::string& antagonist;
+        const common::MemoryBackend backend;
         const std::size_t buffer_size;
         const std::size_t padded_element_size;
+        const std::size_t element_offset;
         const std::size_t page_size;
         const std::int32_t num_logical_loads;
         std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
@@ -53,19 +57,22 @@ namespace memory_latency
 
     void print_csv_header()
     {
-        std::cout
-            << "BufferSize,PaddedElementSize,PageSize,NumLogicalLoads,Cycles,L1DMisses,L2Misses,L3Misses,TLBMisses\n";
+        std::cout << "Antagonist,MemoryBackend,BufferSize,PaddedElementSize,ElementOffset,PageSize,NumLogicalLoads,"
+                     "Cycles,L1DMisses,L2Misses,L3Misses,TLBMisses\n";
     }
 
     void print_csv_row(const BenchmarkResult& result)
     {
-        std::cout << result.buffer_size << "," << result.padded_element_size << "," << result.page_size << ","
+        std::cout << result.antagonist << "," << to_string(result.backend) << "," << result.buffer_size << ","
+                  << result.padded_element_size << "," << result.element_offset << "," << result.page_size << ","
                   << result.num_logical_loads << "," << result.cycle_count << "," << result.l1d_miss_count << ","
                   << result.l2_miss_count << "," << result.l3_miss_count << "," << result.tlb_miss_count << "\n";
     }
 
-    void run_benchmark(const std::size_t buffer_size_in_bytes, const std::size_t padded_bytes_per_element,
-                       const bool use_hugepage)
+    // `element_offset` places each pointer that many bytes into its element; see `generate_random_pointer_chasing`
+    void run_benchmark(const std::string& antagonist, const common::MemoryBackend backend,
+                       const std::size_t buffer_size_in_bytes, const std::size_t padded_bytes_per_element,
+                       const std::size_t element_offset)
     {
         constexpr auto NUM_LOGICAL_LOADS = std::int32_t{1'000'000};
         constexpr auto NUM_TRIALS = std::int32_t{10};
@@ -78,29 +85,14 @@ namespace memory_latency
             return;
         }
         const auto num_elements = buffer_size_in_bytes / padded_bytes_per_element;
-        const auto page_size = use_hugepage ? common::get_hugepage_size() : common::get_page_size();
 
-        auto buffer = common::allocate_aligned_buffer<MemoryAddress>(buffer_size_in_bytes, page_size);
+        // The pointer of the last element extends past the buffer when it straddles the end of its element
+        const auto is_straddling = element_offset + sizeof(common::MemoryAddress) > padded_bytes_per_element;
+        const auto buffer =
+            common::MemoryBuffer(buffer_size_in_bytes + (is_straddling ? sizeof(common::MemoryAddress) : 0), backend);
 
-        if (use_hugepage)
-        {
-            if (madvise(static_cast<void*>(buffer.get()), buffer_size_in_bytes, MADV_HUGEPAGE) != 0)
-
-            {
-                std::cerr << "Warning: madvise(MADV_HUGEPAGE) failed: " << std::strerror(errno) << "\n";
-            }
-        }
-        else
-        {
-            if (madvise(static_cast<void*>(buffer.get()), buffer_size_in_bytes, MADV_NOHUGEPAGE) != 0)
-
-            {
-                std::cerr << "Warning: madvise(MADV_NOHUGEPAGE) failed: " << std::strerror(errno) << "\n";
-            }
-        }
-
-        auto* const start_ptr =
-            generate_random_pointer_chasing(buffer.get(), num_elements, padded_bytes_per_element, RAND_SEED);
+        auto* const start_ptr = common::generate_random_pointer_chasing(
+            buffer.data<common::MemoryAddress>(), num_elements, padded_bytes_per_element, RAND_SEED, element_offset);
 
         const auto open_counter = [](const char* name, const std::int32_t group_fd) {
             const auto counter = perf_counter_open_by_name(name, group_fd);
@@ -145,9 +137,11 @@ namespace memory_latency
 
         perf_counter_enable(&cycle_counter);
 
-        auto* volatile kernel = walk_pointer_chain<NUM_LOGICAL_LOADS>;
+        auto* volatile kernel = common::walk_pointer_chain<NUM_LOGICAL_LOADS>;
 
-        auto result = BenchmarkResult{buffer_size_in_bytes, padded_bytes_per_element, page_size, NUM_LOGICAL_LOADS};
+        auto result = BenchmarkResult{
+            antagonist, backend, buffer_size_in_bytes, padded_bytes_per_element, element_offset, buffer.page_size(),
+            NUM_LOGICAL_LOADS};
 
         for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
         {
@@ -191,21 +185,58 @@ namespace memory_latency
 
 }  // namespace memory_latency
 
-int main()
+// Usage: memory_latency [antagonist_profile...]
+// Repeats the sweep under each profile (see `common::parse_antagonist_profile`), or once without antagonists, for each
+// memory backend (see `common::get_memory_backends`), by default THP and base pages.
+int main(int argc, char* argv[])
 {
+    constexpr auto MIN_BUFFER_SIZE = 16 * common::KiB;
+    constexpr auto MAX_BUFFER_SIZE = 1 * common::GiB;
+
+    // Bytes of each split pointer that lie before the boundary
+    constexpr auto SPLIT_OVERLAP = sizeof(common::MemoryAddress) / 2;
+
     memory_latency::print_csv_header();
 
     try
     {
         const auto cache_line_bytes = common::get_cache_line_bytes();
         const auto page_size = common::get_page_size();
+        const auto backends =
+            common::get_memory_backends({common::MemoryBackend::Thp, common::MemoryBackend::Anonymous});
+
+        auto profiles = std::vector<common::AntagonistProfile>();
+        for (int i = 1; i < argc; ++i)
+        {
+            profiles.push_back(common::parse_antagonist_profile(argv[i]));
+        }
+        if (profiles.empty())
+        {
+            profiles.push_back(common::AntagonistProfile{});
+        }
 
-        for (auto size = 16 * common::KiB; size <= 1 * common::GiB; size *= 2)  // NOLINT(readability-magic-numbers)
+        // Stay on one CPU so that the antagonists can be kept off it
+        const auto cpu = common::get_available_cpus().front();
+        common::pin_current_thread_to_cpu(cpu);
+
+        for (const auto& profile : profiles)
         {
-            memory_latency::run_benchmark(size, cache_line_bytes, true);
+            const auto antagonist = common::to_string(profile);
+            const auto neighbors = common::NoisyNeighbors(profile, cpu);
+
+            for (const auto backend : backends)
+            {
+                for (auto size = MIN_BUFFER_SIZE; size <= MAX_BUFFER_SIZE; size *= 2)
+                {
+                    memory_latency::run_benchmark(antagonist, backend, size, cache_line_bytes, 0);
+                    memory_latency::run_benchmark(antagonist, backend, size, page_size, 0);
 
-            memory_latency::run_benchmark(size, page_size, true);
-            memory_latency::run_benchmark(size, page_size, false);
+                    // Pointers straddling a cache-line boundary, and a 4 KiB page boundary
+                    memory_latency::run_benchmark(antagonist, backend, size, cache_line_bytes,
+                                                  cache_line_bytes - SPLIT_OVERLAP);
+                    memory_latency::run_benchmark(antagonist, backend, size, page_size, page_size - SPLIT_OVERLAP);
+                }
+            }
         }
     }
     catch (const std::exception& e)
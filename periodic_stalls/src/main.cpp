@@ -0,0 +1,154 @@
+#include "common.hpp"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <x86intrin.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace periodic_stalls
+{
+    // Far larger than the last-level cache, so every load goes to DRAM
+    constexpr auto CHAIN_BUFFER_SIZE = 512 * common::MiB;
+
+    // A block of a few DRAM loads lasts about a microsecond, well below half of the shortest refresh interval
+    constexpr auto LOADS_PER_BLOCK = std::int32_t{8};
+
+    constexpr auto SAMPLES_PER_SEGMENT = std::size_t{4096};
+    constexpr auto NUM_SEGMENTS = std::size_t{2048};
+
+    constexpr auto MAX_FFT_SIZE = std::size_t{1} << 22U;
+    constexpr auto NUM_PEAKS = std::size_t{10};
+    constexpr auto DEFAULT_DURATION_SECONDS = std::int32_t{10};
+
+    struct RunSummary
+    {
+        const common::MemoryBackend backend;
+        const std::int32_t duration_seconds;
+        const std::uint64_t median_block_ticks;
+        const std::uint64_t bin_ticks;
+        const std::size_t num_bins;
+        const double tsc_hz;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,DurationSeconds,LoadsPerBlock,MedianBlockTscTicks,BinTscTicks,NumBins,Rank,"
+                     "FrequencyHz,PeriodMicroseconds,AmplitudeTscTicks,PowerToMeanRatio,Autocorrelation\n";
+    }
+
+    void print_csv_row(const RunSummary& summary, const std::size_t rank, const std::size_t frequency_bin,
+                       const Spectrum& spectrum)
+    {
+        const auto window_seconds = static_cast<double>(summary.bin_ticks * summary.num_bins) / summary.tsc_hz;
+        const auto frequency_hz = static_cast<double>(frequency_bin) / window_seconds;
+        const auto lag = static_cast<std::size_t>(
+            std::lround(static_cast<double>(summary.num_bins) / static_cast<double>(frequency_bin)));
+
+        // Amplitude of the sinusoid at this frequency, in excess ticks per bin
+        const auto amplitude = 2.0 * std::sqrt(spectrum.power[frequency_bin]) / static_cast<double>(summary.num_bins);
+
+        std::cout << to_string(summary.backend) << "," << summary.duration_seconds << "," << LOADS_PER_BLOCK << ","
+                  << summary.median_block_ticks << "," << summary.bin_ticks << "," << summary.num_bins << "," << rank
+                  << "," << frequency_hz << "," << 1e6 / frequency_hz << "," << amplitude << ","
+                  << spectrum.power[frequency_bin] / spectrum.mean_power << ","
+                  << spectrum.autocorrelation[lag % summary.num_bins] << "\n";
+    }
+
+    // Largest power of 2 not exceeding `value`
+    [[nodiscard]] std::size_t floor_power_of_two(const std::size_t value) noexcept
+    {
+        auto result = std::size_t{1};
+        while (result <= value / 2)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+
+    void run_benchmark(const common::MemoryBackend backend, const std::int32_t duration_seconds)
+    {
+        constexpr auto RAND_SEED = std::uint64_t{12345};
+
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+
+        const auto buffer = common::MemoryBuffer(CHAIN_BUFFER_SIZE, backend);
+
+        auto* current_ptr = common::generate_random_pointer_chasing(
+            buffer.data<common::MemoryAddress>(), CHAIN_BUFFER_SIZE / cache_line_bytes, cache_line_bytes, RAND_SEED);
+
+        auto ring = TimestampRing(NUM_SEGMENTS, SAMPLES_PER_SEGMENT);
+        auto* volatile kernel = common::walk_pointer_chain_sampled<LOADS_PER_BLOCK>;
+
+        // The chase runs until the deadline, keeping the most recent segments once the ring wraps
+        const auto start_time = std::chrono::steady_clock::now();
+        const auto start_tsc = __rdtsc();
+        const auto deadline = start_time + std::chrono::seconds(duration_seconds);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            current_ptr = kernel(current_ptr, ring.next_segment(), SAMPLES_PER_SEGMENT);
+        }
+        const auto end_tsc = __rdtsc();
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        const auto tsc_hz = static_cast<double>(end_tsc - start_tsc) / elapsed;
+
+        const auto median_block_ticks = get_median_block_ticks(ring);
+        const auto bin_ticks = std::max(median_block_ticks, std::uint64_t{1});
+        const auto span_ticks = ring.segment(ring.size() - 1)[SAMPLES_PER_SEGMENT] - ring.segment(0)[0];
+        const auto num_bins = std::min(floor_power_of_two(span_ticks / bin_ticks), MAX_FFT_SIZE);
+
+        const auto series = resample_excess_ticks(ring, median_block_ticks, bin_ticks, num_bins);
+        const auto spectrum = analyze_series(series);
+        const auto peaks = find_peaks(spectrum.power, NUM_PEAKS);
+
+        const auto summary = RunSummary{backend, duration_seconds, median_block_ticks, bin_ticks, num_bins, tsc_hz};
+        for (std::size_t i = 0; i < peaks.size(); ++i)
+        {
+            print_csv_row(summary, i + 1, peaks[i], spectrum);
+        }
+    }
+
+}  // namespace periodic_stalls
+
+// Usage: periodic_stalls [duration_seconds]
+// Chases a DRAM-sized chain for the given time and reports the strongest periodic components of its stall time, for
+// each memory backend (see `common::get_memory_backends`), by default THP.
+int main(int argc, char* argv[])
+{
+    periodic_stalls::print_csv_header();
+
+    try
+    {
+        auto duration_seconds = periodic_stalls::DEFAULT_DURATION_SECONDS;
+        if (argc > 1)
+        {
+            duration_seconds = std::stoi(argv[1]);
+            if (duration_seconds <= 0)
+            {
+                throw std::invalid_argument("`duration_seconds` must be positive.");
+            }
+        }
+
+        // Stay on one CPU so that every timestamp comes from the same TSC
+        common::pin_current_thread_to_cpu(common::get_available_cpus().front());
+
+        for (const auto backend : common::get_memory_backends({common::MemoryBackend::Thp}))
+        {
+            periodic_stalls::run_benchmark(backend, duration_seconds);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace periodic_stalls
+{
+    // Timestamps in a ring of fixed-size segments; each segment is filled by one call of the sampled kernel, so it
+    // holds `samples_per_segment + 1` timestamps and its first one is the start of its first block
+    class TimestampRing
+    {
+    public:
+        TimestampRing(const std::size_t num_segments, const std::size_t samples_per_segment)
+            : num_segments_(num_segments),
+              samples_per_segment_(samples_per_segment),
+              timestamps_(num_segments * (samples_per_segment + 1))
+        {
+            if (num_segments == 0 || samples_per_segment == 0)
+            {
+                throw std::invalid_argument("`num_segments` and `samples_per_segment` must not be zero.");
+            }
+        }
+
+        [[nodiscard]] std::size_t samples_per_segment() const noexcept { return samples_per_segment_; }
+
+        // Segment to fill next; overwrites the oldest one once the ring is full
+        [[nodiscard]] std::uint64_t* next_segment() noexcept
+        {
+            auto* const segment = get_segment(num_filled_ % num_segments_);
+            ++num_filled_;
+            return segment;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return std::min(num_filled_, num_segments_); }
+
+        // `index` 0 is the oldest segment still in the ring
+        [[nodiscard]] const std::uint64_t* segment(const std::size_t index) const noexcept
+        {
+            const auto first = num_filled_ > num_segments_ ? num_filled_ % num_segments_ : 0;
+            return timestamps_.data() + (((first + index) % num_segments_) * (samples_per_segment_ + 1));
+        }
+
+    private:
+        [[nodiscard]] std::uint64_t* get_segment(const std::size_t slot) noexcept
+        {
+            return timestamps_.data() + (slot * (samples_per_segment_ + 1));
+        }
+
+        std::size_t num_segments_;
+        std::size_t samples_per_segment_;
+        std::size_t num_filled_ = 0;
+        std::vector<std::uint64_t> timestamps_;
+    };
+
+    [[nodiscard]] inline std::uint64_t get_median_block_ticks(const TimestampRing& ring)
+    {
+        auto durations = std::vector<std::uint64_t>();
+        durations.reserve(ring.size() * ring.samples_per_segment());
+        for (std::size_t i = 0; i < ring.size(); ++i)
+        {
+            const auto* const timestamps = ring.segment(i);
+            for (std::size_t j = 1; j <= ring.samples_per_segment(); ++j)
+            {
+                durations.push_back(timestamps[j] - timestamps[j - 1]);
+            }
+        }
+
+        if (durations.empty())
+        {
+            throw std::runtime_error("No blocks were recorded.");
+        }
+
+        const auto middle = durations.begin() + static_cast<std::ptrdiff_t>(durations.size() / 2);
+        std::nth_element(durations.begin(), middle, durations.end());
+        return *middle;
+    }
+
+    // Excess time over `median_ticks` of every block, summed into bins of `bin_ticks` by the end time of the block.
+    // Covers the most recent `num_bins` bins; the blocks run back to back, so this is a uniformly sampled series of the
+    // time lost to stalls.
+    [[nodiscard]] inline std::vector<double> resample_excess_ticks(const TimestampRing& ring,
+                                                                   const std::uint64_t median_ticks,
+                                                                   const std::uint64_t bin_ticks,
+                                                                   const std::size_t num_bins)
+    {
+        const auto last_timestamp = ring.segment(ring.size() - 1)[ring.samples_per_segment()];
+        const auto window_ticks = bin_ticks * num_bins;
+        const auto window_start = last_timestamp > window_ticks ? last_timestamp - window_ticks : 0;
+
+        auto series = std::vector<double>(num_bins, 0.0);
+        for (std::size_t i = 0; i < ring.size(); ++i)
+        {
+            const auto* const timestamps = ring.segment(i);
+            for (std::size_t j = 1; j <= ring.samples_per_segment(); ++j)
+            {
+                const auto duration = timestamps[j] - timestamps[j - 1];
+                if (timestamps[j] <= window_start || duration <= median_ticks)
+                {
+                    continue;
+                }
+
+                const auto bin = std::min((timestamps[j] - window_start - 1) / bin_ticks, std::uint64_t{num_bins - 1});
+                series[bin] += static_cast<double>(duration - median_ticks);
+            }
+        }
+        return series;
+    }
+
+    // In-place iterative radix-2 FFT; the size must be a power of 2. The inverse transform is not normalized.
+    inline void fft(std::vector<std::complex<double>>& values, const bool inverse)
+    {
+        const auto size = values.size();
+        if (size == 0 || (size & (size - 1)) != 0)
+        {
+            throw std::invalid_argument("FFT size must be a power of 2.");
+        }
+
+        for (std::size_t i = 1, j = 0; i < size; ++i)
+        {
+            auto bit = size >> 1U;
+            for (; (j & bit) != 0; bit >>= 1U)
+            {
+                j ^= bit;
+            }
+            j ^= bit;
+
+            if (i < j)
+            {
+                std::swap(values[i], values[j]);
+            }
+        }
+
+        const auto sign = inverse ? 1.0 : -1.0;
+        for (std::size_t length = 2; length <= size; length <<= 1U)
+        {
+            const auto angle = sign * 2.0 * M_PI / static_cast<double>(length);
+            const auto step = std::complex<double>(std::cos(angle), std::sin(angle));
+            for (std::size_t start = 0; start < size; start += length)
+            {
+                auto twiddle = std::complex<double>(1.0, 0.0);
+                for (std::size_t k = 0; k < length / 2; ++k)
+                {
+                    const auto even = values[start + k];
+                    const auto odd = values[start + k + (length / 2)] * twiddle;
+                    values[start + k] = even + odd;
+                    values[start + k + (length / 2)] = even - odd;
+                    twiddle *= step;
+                }
+            }
+        }
+    }
+
+    struct Spectrum
+    {
+        // Squared magnitude of frequency bins 0 to size / 2
+        std::vector<double> power;
+        // Circular autocorrelation normalized by its value at lag 0
+        std::vector<double> autocorrelation;
+        // Mean of `power` excluding bin 0; the noise floor that peaks are compared against
+        double mean_power = 0.0;
+    };
+
+    [[nodiscard]] inline Spectrum analyze_series(const std::vector<double>& series)
+    {
+        const auto size = series.size();
+        auto mean = 0.0;
+        for (const auto value : series)
+        {
+            mean += value;
+        }
+        mean /= static_cast<double>(size);
+
+        auto values = std::vector<std::complex<double>>(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            values[i] = series[i] - mean;
+        }
+
+        fft(values, false);
+
+        auto spectrum = Spectrum{std::vector<double>(size / 2 + 1), std::vector<double>(size)};
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const auto power = std::norm(values[i]);
+            if (i <= size / 2)
+            {
+                spectrum.power[i] = power;
+                spectrum.mean_power += i == 0 ? 0.0 : power / static_cast<double>(size / 2);
+            }
+            values[i] = power;
+        }
+
+        // Wiener-Khinchin: the autocorrelation is the inverse transform of the power spectrum
+        fft(values, true);
+        const auto zero_lag = values[0].real();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            spectrum.autocorrelation[i] = zero_lag > 0.0 ? values[i].real() / zero_lag : 0.0;
+        }
+        return spectrum;
+    }
+
+    // Frequency bins of the `max_peaks` strongest local maxima of the power spectrum, strongest first
+    [[nodiscard]] inline std::vector<std::size_t> find_peaks(const std::vector<double>& power,
+                                                             const std::size_t max_peaks)
+    {
+        auto peaks = std::vector<std::size_t>();
+        for (std::size_t i = 1; i + 1 < power.size(); ++i)
+        {
+            if (power[i] > power[i - 1] && power[i] >= power[i + 1])
+            {
+                peaks.push_back(i);
+            }
+        }
+
+        std::sort(peaks.begin(), peaks.end(), [&](const auto lhs, const auto rhs) { return power[lhs] > power[rhs]; });
+        if (peaks.size() > max_peaks)
+        {
+            peaks.resize(max_peaks);
+        }
+        return peaks;
+    }
+
+}  // namespace periodic_stalls
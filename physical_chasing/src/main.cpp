@@ -0,0 +1,156 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <ios>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace physical_chasing
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    // Regular pages, so that the physical layout is up to the kernel's allocator
+    constexpr auto POOL_SIZE = 1 * common::GiB;
+
+    constexpr auto MIN_ELEMENTS = std::size_t{256};
+    constexpr auto MAX_ELEMENTS = std::size_t{4} * 1024 * 1024;
+
+    struct BenchmarkResult
+    {
+        const std::string& selection;
+        const std::uint64_t physical_mask;
+        const std::size_t num_elements;
+        const PhysicalLayout layout;
+        const std::int32_t num_logical_loads;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Selection,PhysicalMask,NumElements,NumPages,NumPhysicalRuns,NumLogicalLoads,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << result.selection << "," << std::hex << std::showbase << result.physical_mask << std::dec
+                  << std::noshowbase << "," << result.num_elements << "," << result.layout.num_pages << ","
+                  << result.layout.num_physical_runs << "," << result.num_logical_loads << "," << result.cycle_count
+                  << "\n";
+    }
+
+    void run_benchmark(const PhysicalPool& pool, const Selection& selection,
+                       const std::vector<common::MemoryAddress*>& elements)
+    {
+        constexpr auto NUM_LOGICAL_LOADS = std::int32_t{1'000'000};
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+        constexpr auto RAND_SEED = std::uint64_t{12345};
+
+        auto* const start_ptr = common::link_random_pointer_chasing(elements, RAND_SEED);
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        auto* volatile kernel = common::walk_pointer_chain<NUM_LOGICAL_LOADS>;
+
+        auto result = BenchmarkResult{selection.name, selection.physical_mask, elements.size(),
+                                      describe_layout(pool, elements), NUM_LOGICAL_LOADS};
+
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_cycles = perf_counter_read(&cycle_counter);
+
+            kernel(start_ptr);
+
+            const auto end_cycles = perf_counter_read(&cycle_counter);
+
+            const auto cycles = end_cycles - start_cycles;
+            if (i >= NUM_WARMUPS && cycles < result.cycle_count)
+            {
+                result.cycle_count = cycles;
+            }
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+    // Lines sharing the page color of a cache level all compete for 1/colors of its sets
+    void add_page_color_selection(std::vector<Selection>& selections, const std::string& name,
+                                  const std::int32_t level, const std::size_t page_size)
+    {
+        const auto num_colors = common::get_cache_page_colors(level);
+        if (num_colors > 1)
+        {
+            selections.push_back({name, static_cast<std::uint64_t>((num_colors - 1) * page_size)});
+        }
+    }
+
+}  // namespace physical_chasing
+
+// Usage: physical_chasing [physical_mask...]
+// Requires CAP_SYS_ADMIN. Each mask (e.g. a DRAM bank function or slice hash bits) adds a selection of lines that
+// share those physical address bits, next to the default page-color selections.
+int main(int argc, char* argv[])
+{
+    physical_chasing::print_csv_header();
+
+    try
+    {
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+        const auto page_size = common::get_page_size();
+
+        auto selections = std::vector<physical_chasing::Selection>{{"Any", 0}};
+        physical_chasing::add_page_color_selection(selections, "SameL2Color", 2, page_size);
+        physical_chasing::add_page_color_selection(selections, "SameL3Color", 3, page_size);
+        for (int i = 1; i < argc; ++i)
+        {
+            selections.push_back({"Mask", std::stoull(argv[i], nullptr, 0)});
+        }
+
+        auto buffer = common::allocate_aligned_buffer<unsigned char>(physical_chasing::POOL_SIZE, page_size);
+        common::advise_hugepage(buffer.get(), physical_chasing::POOL_SIZE, false);
+
+        // Fault every page in so that it has a frame to report
+        std::memset(buffer.get(), 0, physical_chasing::POOL_SIZE);
+
+        const auto frame_numbers = common::get_physical_frame_numbers(buffer.get(), physical_chasing::POOL_SIZE);
+        const auto pool = physical_chasing::PhysicalPool{buffer.get(), frame_numbers, page_size, cache_line_bytes};
+
+        for (const auto& selection : selections)
+        {
+            const auto matches =
+                physical_chasing::select_lines(pool, selection.physical_mask, physical_chasing::MAX_ELEMENTS);
+
+            for (auto num_elements = physical_chasing::MIN_ELEMENTS; num_elements <= matches.size(); num_elements *= 2)
+            {
+                const auto elements = std::vector<common::MemoryAddress*>(
+                    matches.begin(), matches.begin() + static_cast<std::ptrdiff_t>(num_elements));
+                physical_chasing::run_benchmark(pool, selection, elements);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "pointer_chasing.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace physical_chasing
+{
+    // Elements are the cache lines whose physical address agrees with that of the first line of the pool in the bits
+    // of `physical_mask`; a mask of 0 selects every line
+    struct Selection
+    {
+        std::string name;
+        std::uint64_t physical_mask;
+    };
+
+    // Physically backed pool of lines to select elements from, with the frame number of each of its pages
+    struct PhysicalPool
+    {
+        unsigned char* const buffer;
+        const std::vector<std::uint64_t>& frame_numbers;
+        const std::size_t page_size;
+        const std::size_t line_size;
+
+        [[nodiscard]] std::uint64_t get_physical_address(const std::size_t offset) const noexcept
+        {
+            return (frame_numbers[offset / page_size] * page_size) + (offset % page_size);
+        }
+    };
+
+    struct PhysicalLayout
+    {
+        std::size_t num_pages = 0;
+        // Maximal ranges of consecutive physical frames among those pages
+        std::size_t num_physical_runs = 0;
+    };
+
+    // Up to `max_elements` matching lines in virtual address order
+    [[nodiscard]] inline std::vector<common::MemoryAddress*> select_lines(const PhysicalPool& pool,
+                                                                          const std::uint64_t physical_mask,
+                                                                          const std::size_t max_elements)
+    {
+        const auto pool_size = pool.frame_numbers.size() * pool.page_size;
+        const auto reference = pool.get_physical_address(0) & physical_mask;
+
+        auto elements = std::vector<common::MemoryAddress*>();
+        for (std::size_t offset = 0; offset < pool_size && elements.size() < max_elements; offset += pool.line_size)
+        {
+            if ((pool.get_physical_address(offset) & physical_mask) == reference)
+            {
+                elements.push_back(reinterpret_cast<common::MemoryAddress*>(pool.buffer + offset));
+            }
+        }
+        return elements;
+    }
+
+    [[nodiscard]] inline PhysicalLayout describe_layout(const PhysicalPool& pool,
+                                                        const std::vector<common::MemoryAddress*>& elements)
+    {
+        auto frames = std::vector<std::uint64_t>();
+        for (auto* const element : elements)
+        {
+            const auto offset = static_cast<std::size_t>(reinterpret_cast<unsigned char*>(element) - pool.buffer);
+            frames.push_back(pool.frame_numbers[offset / pool.page_size]);
+        }
+        std::sort(frames.begin(), frames.end());
+        frames.erase(std::unique(frames.begin(), frames.end()), frames.end());
+
+        auto layout = PhysicalLayout{frames.size(), 0};
+        for (std::size_t i = 0; i < frames.size(); ++i)
+        {
+            if (i == 0 || frames[i] != frames[i - 1] + 1)
+            {
+                ++layout.num_physical_runs;
+            }
+        }
+        return layout;
+    }
+
+}  // namespace physical_chasing
@@ -0,0 +1,245 @@
+#include "common.hpp"
+#include "queues.hpp"
+#include "utils.hpp"
+
+#include <x86intrin.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace queue_latency
+{
+    constexpr auto QUEUE_CAPACITY = std::size_t{1024};
+    constexpr auto BATCH_SIZES = std::array<std::size_t, 4>{1, 4, 16, 64};
+
+    constexpr auto PAIR_RELATIONS =
+        std::array<common::CpuRelation, 4>{common::CpuRelation::SmtSibling, common::CpuRelation::SharedL3,
+                                           common::CpuRelation::SamePackage, common::CpuRelation::RemotePackage};
+
+    // Producer on `cpus[0]`, consumer on `cpus[1]`
+    struct ThreadPlacement
+    {
+        std::string name;
+        std::vector<std::int32_t> cpus;
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ConsumerProgress
+    {
+        std::atomic<std::size_t> num_received{0};
+    };
+
+    struct BenchmarkResult
+    {
+        const char* const queue_name;
+        const std::string placement;
+        const std::size_t message_bytes;
+        const std::size_t batch_size;
+        const Mode mode;
+        const std::size_t num_messages;
+        std::int64_t elapsed_ns = std::numeric_limits<std::int64_t>::max();
+        LatencySummary latency = {};
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Queue,Placement,MessageSize,BatchSize,Mode,Messages,Nanoseconds,MedianLatencyTscTicks,"
+                     "P99LatencyTscTicks,MeanLatencyTscTicks\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << result.queue_name << "," << result.placement << "," << result.message_bytes << ","
+                  << result.batch_size << "," << to_string(result.mode) << "," << result.num_messages << ","
+                  << result.elapsed_ns << "," << result.latency.median << "," << result.latency.p99 << ","
+                  << result.latency.mean << "\n";
+    }
+
+    [[nodiscard]] std::vector<ThreadPlacement> build_placements(const std::vector<std::int32_t>& cpus)
+    {
+        const auto first = common::get_cpu_location(cpus.front());
+
+        auto placements = std::vector<ThreadPlacement>();
+        for (const auto relation : PAIR_RELATIONS)
+        {
+            const auto it = std::find_if(cpus.begin(), cpus.end(), [&](const std::int32_t cpu) {
+                return common::get_cpu_relation(first, common::get_cpu_location(cpu)) == relation;
+            });
+            if (it != cpus.end())
+            {
+                placements.push_back({common::to_string(relation), {cpus.front(), *it}});
+            }
+        }
+
+        if (placements.empty())
+        {
+            throw std::runtime_error("At least two CPUs are required.");
+        }
+        return placements;
+    }
+
+    template <typename Queue, typename Message>
+    void produce(Queue& queue, const std::size_t batch_size, const Mode mode, const std::size_t num_messages,
+                 const ConsumerProgress& progress)
+    {
+        auto batch = std::vector<Message>(batch_size);
+
+        for (std::size_t num_sent = 0; num_sent < num_messages;)
+        {
+            const auto num_items = std::min(batch_size, num_messages - num_sent);
+            const auto tsc = __rdtsc();
+            for (std::size_t i = 0; i < num_items; ++i)
+            {
+                batch[i].tsc = tsc;
+                batch[i].sequence = num_sent + i;
+            }
+
+            for (std::size_t num_pushed = 0; num_pushed < num_items;)
+            {
+                const auto n = queue.push(batch.data() + num_pushed, num_items - num_pushed);
+                if (n == 0)
+                {
+                    _mm_pause();
+                }
+                num_pushed += n;
+            }
+            num_sent += num_items;
+
+            if (mode == Mode::Latency)
+            {
+                while (progress.num_received.load(std::memory_order_acquire) < num_sent)
+                {
+                    _mm_pause();
+                }
+            }
+        }
+    }
+
+    // Records the one-way latency of every message and returns the number of messages that arrived out of order
+    template <typename Queue, typename Message>
+    [[nodiscard]] std::size_t consume(Queue& queue, const std::size_t batch_size, std::vector<std::uint64_t>& latencies,
+                                      ConsumerProgress& progress)
+    {
+        auto batch = std::vector<Message>(batch_size);
+        auto num_out_of_order = std::size_t{0};
+
+        for (std::size_t num_received = 0; num_received < latencies.size();)
+        {
+            const auto n = queue.pop(batch.data(), std::min(batch_size, latencies.size() - num_received));
+            if (n == 0)
+            {
+                _mm_pause();
+                continue;
+            }
+
+            const auto tsc = __rdtsc();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                num_out_of_order += batch[i].sequence != num_received + i ? 1 : 0;
+                latencies[num_received + i] = tsc - batch[i].tsc;
+            }
+            num_received += n;
+            progress.num_received.store(num_received, std::memory_order_release);
+        }
+
+        return num_out_of_order;
+    }
+
+    template <template <typename> typename Queue, typename Message>
+    void run_benchmark(const ThreadPlacement& placement, const std::size_t batch_size, const Mode mode,
+                       const std::size_t num_messages)
+    {
+        constexpr auto NUM_TRIALS = std::int32_t{5};
+
+        auto result = BenchmarkResult{Queue<Message>::NAME, placement.name, sizeof(Message), batch_size, mode,
+                                      num_messages};
+
+        for (std::int32_t i = 0; i < NUM_TRIALS; ++i)
+        {
+            auto queue = Queue<Message>(QUEUE_CAPACITY);
+            auto progress = ConsumerProgress{};
+            auto latencies = std::vector<std::uint64_t>(num_messages);
+            auto num_out_of_order = std::size_t{0};
+
+            const auto elapsed_ns = common::run_pinned_threads(placement.cpus, [&](const std::size_t thread_index) {
+                if (thread_index == 0)
+                {
+                    produce<Queue<Message>, Message>(queue, batch_size, mode, num_messages, progress);
+                }
+                else
+                {
+                    num_out_of_order = consume<Queue<Message>, Message>(queue, batch_size, latencies, progress);
+                }
+            });
+
+            if (num_out_of_order != 0)
+            {
+                std::cerr << "Error: Queue '" << Queue<Message>::NAME << "' delivered " << num_out_of_order
+                          << " messages out of order.\n";
+                return;
+            }
+
+            if (elapsed_ns < result.elapsed_ns)
+            {
+                result.elapsed_ns = elapsed_ns;
+                result.latency = summarize_latencies(latencies);
+            }
+        }
+
+        print_csv_row(result);
+    }
+
+    template <typename Message>
+    void run_benchmarks(const ThreadPlacement& placement, const std::size_t batch_size, const Mode mode,
+                        const std::size_t num_messages)
+    {
+        run_benchmark<SpscQueue, Message>(placement, batch_size, mode, num_messages);
+        run_benchmark<MpmcQueue, Message>(placement, batch_size, mode, num_messages);
+        run_benchmark<MutexQueue, Message>(placement, batch_size, mode, num_messages);
+    }
+
+}  // namespace queue_latency
+
+int main()
+{
+    constexpr auto NUM_LATENCY_MESSAGES = std::size_t{100'000};
+    constexpr auto NUM_THROUGHPUT_MESSAGES = std::size_t{1'000'000};
+
+    queue_latency::print_csv_header();
+
+    try
+    {
+        const auto placements = queue_latency::build_placements(common::get_available_cpus());
+
+        for (const auto& placement : placements)
+        {
+            for (const auto mode : {queue_latency::Mode::Latency, queue_latency::Mode::Throughput})
+            {
+                const auto num_messages =
+                    mode == queue_latency::Mode::Latency ? NUM_LATENCY_MESSAGES : NUM_THROUGHPUT_MESSAGES;
+
+                for (const auto batch_size : queue_latency::BATCH_SIZES)
+                {
+                    using namespace queue_latency;
+                    run_benchmarks<Message<32>>(placement, batch_size, mode, num_messages);
+                    run_benchmarks<Message<64>>(placement, batch_size, mode, num_messages);
+                    run_benchmarks<Message<256>>(placement, batch_size, mode, num_messages);
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
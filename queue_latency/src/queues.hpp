@@ -0,0 +1,275 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+// All queues hold trivially copyable items in a power-of-2 ring. `push` and `pop` transfer up to `count` items and
+// return how many were transferred; the lock-free queues return 0 instead of waiting, while the condition-variable
+// queue blocks until at least one item can be transferred.
+namespace queue_latency
+{
+    constexpr auto CACHE_LINE_SIZE = std::size_t{64};
+
+    namespace detail
+    {
+        inline void validate_capacity(const std::size_t capacity)
+        {
+            if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+            {
+                throw std::invalid_argument("`capacity` must be a power of 2.");
+            }
+        }
+    }  // namespace detail
+
+    // Single-producer single-consumer ring. Each side keeps a cached copy of the other side's index on its own line and
+    // only reloads it when the ring looks full (or empty), so a batch costs one index publication.
+    template <typename T>
+    class SpscQueue
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "`T` must be trivially copyable.");
+
+    public:
+        static constexpr auto NAME = "SPSC";
+
+        explicit SpscQueue(const std::size_t capacity)
+            : capacity_(capacity), slots_(common::allocate_aligned_buffer<T>(capacity * sizeof(T), CACHE_LINE_SIZE))
+        {
+            detail::validate_capacity(capacity);
+        }
+
+        std::size_t push(const T* const items, const std::size_t count) noexcept
+        {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            if (capacity_ - (tail - cached_head_) < count)
+            {
+                cached_head_ = head_.load(std::memory_order_acquire);
+            }
+
+            const auto num_items = std::min(count, capacity_ - (tail - cached_head_));
+            for (std::size_t i = 0; i < num_items; ++i)
+            {
+                slots_.get()[(tail + i) & (capacity_ - 1)] = items[i];
+            }
+            tail_.store(tail + num_items, std::memory_order_release);
+            return num_items;
+        }
+
+        std::size_t pop(T* const items, const std::size_t count) noexcept
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (cached_tail_ - head < count)
+            {
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+            }
+
+            const auto num_items = std::min(count, cached_tail_ - head);
+            for (std::size_t i = 0; i < num_items; ++i)
+            {
+                items[i] = slots_.get()[(head + i) & (capacity_ - 1)];
+            }
+            head_.store(head + num_items, std::memory_order_release);
+            return num_items;
+        }
+
+    private:
+        const std::size_t capacity_;
+        const std::unique_ptr<T, void (*)(void*)> slots_;
+
+        // Consumer-owned line
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{0};
+        std::size_t cached_tail_ = 0;
+
+        // Producer-owned line
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{0};
+        std::size_t cached_head_ = 0;
+    };
+
+    // Dmitry Vyukov's bounded MPMC queue: every cell carries a sequence number that tells producers and consumers
+    // whether it is free for the current lap.
+    template <typename T>
+    class MpmcQueue
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "`T` must be trivially copyable.");
+
+    public:
+        static constexpr auto NAME = "MPMC";
+
+        explicit MpmcQueue(const std::size_t capacity)
+            : capacity_(capacity),
+              cells_(common::allocate_aligned_buffer<Cell>(capacity * sizeof(Cell), CACHE_LINE_SIZE))
+        {
+            detail::validate_capacity(capacity);
+            for (std::size_t i = 0; i < capacity; ++i)
+            {
+                ::new (static_cast<void*>(&cells_.get()[i])) Cell{};
+                cells_.get()[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t push(const T* const items, const std::size_t count) noexcept
+        {
+            std::size_t num_items = 0;
+            while (num_items < count && try_push(items[num_items]))
+            {
+                ++num_items;
+            }
+            return num_items;
+        }
+
+        std::size_t pop(T* const items, const std::size_t count) noexcept
+        {
+            std::size_t num_items = 0;
+            while (num_items < count && try_pop(items[num_items]))
+            {
+                ++num_items;
+            }
+            return num_items;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence{0};
+            T data;
+        };
+
+        bool try_push(const T& item) noexcept
+        {
+            auto position = enqueue_position_.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            for (;;)
+            {
+                cell = &cells_.get()[position & (capacity_ - 1)];
+                const auto sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+                if (difference == 0)
+                {
+                    if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = enqueue_position_.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->data = item;
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_pop(T& item) noexcept
+        {
+            auto position = dequeue_position_.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            for (;;)
+            {
+                cell = &cells_.get()[position & (capacity_ - 1)];
+                const auto sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto difference =
+                    static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+                if (difference == 0)
+                {
+                    if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position = dequeue_position_.load(std::memory_order_relaxed);
+                }
+            }
+
+            item = cell->data;
+            cell->sequence.store(position + capacity_, std::memory_order_release);
+            return true;
+        }
+
+        const std::size_t capacity_;
+        const std::unique_ptr<Cell, void (*)(void*)> cells_;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_position_{0};
+    };
+
+    template <typename T>
+    class MutexQueue
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "`T` must be trivially copyable.");
+
+    public:
+        static constexpr auto NAME = "MutexCondVar";
+
+        explicit MutexQueue(const std::size_t capacity)
+            : capacity_(capacity), slots_(common::allocate_aligned_buffer<T>(capacity * sizeof(T), CACHE_LINE_SIZE))
+        {
+            detail::validate_capacity(capacity);
+        }
+
+        std::size_t push(const T* const items, const std::size_t count)
+        {
+            auto lock = std::unique_lock<std::mutex>(mutex_);
+            not_full_.wait(lock, [this]() { return tail_ - head_ < capacity_; });
+
+            const auto num_items = std::min(count, capacity_ - (tail_ - head_));
+            for (std::size_t i = 0; i < num_items; ++i)
+            {
+                slots_.get()[(tail_ + i) & (capacity_ - 1)] = items[i];
+            }
+            tail_ += num_items;
+
+            lock.unlock();
+            not_empty_.notify_one();
+            return num_items;
+        }
+
+        std::size_t pop(T* const items, const std::size_t count)
+        {
+            auto lock = std::unique_lock<std::mutex>(mutex_);
+            not_empty_.wait(lock, [this]() { return tail_ != head_; });
+
+            const auto num_items = std::min(count, tail_ - head_);
+            for (std::size_t i = 0; i < num_items; ++i)
+            {
+                items[i] = slots_.get()[(head_ + i) & (capacity_ - 1)];
+            }
+            head_ += num_items;
+
+            lock.unlock();
+            not_full_.notify_one();
+            return num_items;
+        }
+
+    private:
+        const std::size_t capacity_;
+        const std::unique_ptr<T, void (*)(void*)> slots_;
+
+        std::mutex mutex_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+        std::size_t head_ = 0;
+        std::size_t tail_ = 0;
+    };
+
+}  // namespace queue_latency
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace queue_latency
+{
+    enum class Mode
+    {
+        // The producer waits for each batch to be consumed before sending the next, so no message ever queues up
+        Latency,
+        // The producer pushes as fast as the queue accepts
+        Throughput,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Mode mode) noexcept
+    {
+        switch (mode)
+        {
+            case Mode::Latency:
+                return "Latency";
+            case Mode::Throughput:
+                return "Throughput";
+        }
+        return "Unknown";
+    }
+
+    // The producer stamps the TSC into every message right before pushing it
+    template <std::size_t MESSAGE_BYTES>
+    struct Message
+    {
+        static_assert(MESSAGE_BYTES % sizeof(std::uint64_t) == 0 && MESSAGE_BYTES > 2 * sizeof(std::uint64_t),
+                      "`MESSAGE_BYTES` must be a multiple of 8 larger than the 16-byte header.");
+
+        std::uint64_t tsc;
+        std::uint64_t sequence;
+        std::array<std::uint64_t, (MESSAGE_BYTES / sizeof(std::uint64_t)) - 2> payload;
+    };
+
+    struct LatencySummary
+    {
+        std::uint64_t median = 0;
+        std::uint64_t p99 = 0;
+        double mean = 0.0;
+    };
+
+    // Reorders `latencies` in place
+    [[nodiscard]] inline LatencySummary summarize_latencies(std::vector<std::uint64_t>& latencies)
+    {
+        auto summary = LatencySummary{};
+        if (latencies.empty())
+        {
+            return summary;
+        }
+
+        auto sum = 0.0;
+        for (const auto latency : latencies)
+        {
+            sum += static_cast<double>(latency);
+        }
+        summary.mean = sum / static_cast<double>(latencies.size());
+
+        const auto median = latencies.begin() + static_cast<std::ptrdiff_t>(latencies.size() / 2);
+        std::nth_element(latencies.begin(), median, latencies.end());
+        summary.median = *median;
+
+        const auto p99 = latencies.begin() + static_cast<std::ptrdiff_t>(latencies.size() * 99 / 100);
+        std::nth_element(median, p99, latencies.end());
+        summary.p99 = *p99;
+
+        return summary;
+    }
+
+}  // namespace queue_latency
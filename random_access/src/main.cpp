@@ -0,0 +1,183 @@
+#include "common.hpp"
+#include "utils.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace random_access
+{
+    constexpr auto OPERATIONS = std::array<Operation, 3>{Operation::Read, Operation::Update, Operation::AtomicUpdate};
+
+    // `node` < 0 keeps the default first-touch policy; `interleave` spreads pages across all nodes.
+    struct NumaPlacement
+    {
+        std::string name;
+        std::int32_t node;
+        bool interleave;
+    };
+
+    struct BenchmarkResult
+    {
+        const common::MemoryBackend backend;
+        const std::size_t table_size;
+        const std::size_t page_size;
+        const std::string numa_policy;
+        const std::size_t num_threads;
+        const Operation operation;
+        const std::size_t updates_per_thread;
+        std::int64_t elapsed_ns = std::numeric_limits<std::int64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,TableSize,PageSize,NumaPolicy,Threads,Operation,UpdatesPerThread,Nanoseconds\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.backend) << "," << result.table_size << "," << result.page_size << ","
+                  << result.numa_policy << "," << result.num_threads << "," << to_string(result.operation) << ","
+                  << result.updates_per_thread << "," << result.elapsed_ns << "\n";
+    }
+
+    using AccessKernel = std::uint64_t (*)(std::uint64_t*, std::size_t, std::uint64_t, std::size_t);
+
+    [[nodiscard]] AccessKernel select_kernel(const Operation operation)
+    {
+        switch (operation)
+        {
+            case Operation::Read:
+                return access_random_words<Operation::Read>;
+            case Operation::Update:
+                return access_random_words<Operation::Update>;
+            case Operation::AtomicUpdate:
+                return access_random_words<Operation::AtomicUpdate>;
+        }
+        return nullptr;
+    }
+
+    void run_benchmark(const common::MemoryBackend backend, const std::size_t table_size_in_bytes,
+                       const NumaPlacement& placement, const std::vector<std::vector<std::int32_t>>& thread_cpu_sets)
+    {
+        constexpr auto UPDATES_PER_THREAD = std::size_t{1} << 22U;
+        constexpr auto NUM_TRIALS = std::int32_t{5};
+        constexpr auto NUM_WARMUPS = std::int32_t{1};
+
+        const auto num_words = table_size_in_bytes / sizeof(std::uint64_t);
+        if (num_words == 0 || (num_words & (num_words - 1)) != 0)
+        {
+            std::cerr << "Error: `table_size_in_bytes` must be a power-of-2 multiple of 8\n";
+            return;
+        }
+
+        const auto buffer = common::MemoryBuffer(table_size_in_bytes, backend);
+        auto* const table = buffer.data<std::uint64_t>();
+
+        if (placement.interleave)
+        {
+            common::interleave_memory_across_numa_nodes(static_cast<void*>(table), table_size_in_bytes);
+        }
+        else if (placement.node >= 0)
+        {
+            common::bind_memory_to_numa_node(static_cast<void*>(table), table_size_in_bytes, placement.node);
+        }
+
+        for (std::size_t i = 0; i < num_words; ++i)
+        {
+            table[i] = i;
+        }
+
+        for (const auto operation : OPERATIONS)
+        {
+            const auto kernel = select_kernel(operation);
+
+            for (const auto& cpus : thread_cpu_sets)
+            {
+                auto result = BenchmarkResult{backend, table_size_in_bytes, buffer.page_size(), placement.name,
+                                              cpus.size(), operation, UPDATES_PER_THREAD};
+
+                for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+                {
+                    auto sink = std::atomic<std::uint64_t>{0};
+                    const auto elapsed_ns = common::run_pinned_threads(cpus, [&](const std::size_t thread_index) {
+                        const auto seed = generate_seed(thread_index);
+                        sink.fetch_add(kernel(table, num_words, seed, UPDATES_PER_THREAD),
+                                       std::memory_order_relaxed);
+                    });
+
+                    if (i >= NUM_WARMUPS && elapsed_ns < result.elapsed_ns)
+                    {
+                        result.elapsed_ns = elapsed_ns;
+                    }
+                }
+
+                print_csv_row(result);
+            }
+        }
+    }
+
+}  // namespace random_access
+
+int main()
+{
+    random_access::print_csv_header();
+
+    try
+    {
+        const auto cpus = common::get_available_cpus();
+
+        // Single thread, then doubling thread counts up to every available CPU
+        auto thread_cpu_sets = std::vector<std::vector<std::int32_t>>();
+        for (std::size_t num_threads = 1; num_threads < cpus.size(); num_threads *= 2)
+        {
+            thread_cpu_sets.emplace_back(cpus.begin(), cpus.begin() + static_cast<std::ptrdiff_t>(num_threads));
+        }
+        thread_cpu_sets.push_back(cpus);
+
+        auto placements = std::vector<random_access::NumaPlacement>{{"Local", -1, false}};
+        const auto num_nodes = common::get_numa_node_count();
+        if (num_nodes > 1)
+        {
+            for (std::int32_t node = 0; node < num_nodes; ++node)
+            {
+                placements.push_back({"Node" + std::to_string(node), node, false});
+            }
+            placements.push_back({"Interleave", -1, true});
+        }
+
+        const auto backends =
+            common::get_memory_backends({common::MemoryBackend::Thp, common::MemoryBackend::Anonymous});
+
+        for (auto size = 16 * common::KiB; size <= 1 * common::GiB; size *= 2)  // NOLINT(readability-magic-numbers)
+        {
+            for (const auto& placement : placements)
+            {
+                for (const auto backend : backends)
+                {
+                    // Backends with a NUMA policy of their own only run with the default placement
+                    const auto has_numa_policy = backend == common::MemoryBackend::NumaLocal ||
+                                                 backend == common::MemoryBackend::NumaInterleaved;
+                    if (has_numa_policy && (placement.interleave || placement.node >= 0))
+                    {
+                        continue;
+                    }
+                    random_access::run_benchmark(backend, size, placement, thread_cpu_sets);
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
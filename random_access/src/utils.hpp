@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace random_access
+{
+    enum class Operation
+    {
+        Read,
+        Update,
+        AtomicUpdate,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Operation operation) noexcept
+    {
+        switch (operation)
+        {
+            case Operation::Read:
+                return "Read";
+            case Operation::Update:
+                return "Update";
+            case Operation::AtomicUpdate:
+                return "AtomicUpdate";
+        }
+        return "Unknown";
+    }
+
+    namespace detail
+    {
+        // Primitive polynomial of the HPCC RandomAccess LFSR
+        constexpr auto POLY = std::uint64_t{0x7};
+
+        [[nodiscard]] constexpr std::uint64_t next_random(const std::uint64_t ran) noexcept
+        {
+            return (ran << 1U) ^ (static_cast<std::int64_t>(ran) < 0 ? POLY : 0);
+        }
+    }  // namespace detail
+
+    [[nodiscard]] constexpr std::uint64_t generate_seed(const std::uint64_t stream_index) noexcept
+    {
+        // SplitMix64 finalizer; the LFSR must not start from zero
+        auto z = (stream_index + 1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31U;
+        return z != 0 ? z : 1;
+    }
+
+    // Issues `num_updates` independent random 8-byte accesses to `table`; `num_words` must be a power of 2.
+    template <Operation OPERATION>
+    std::uint64_t access_random_words(std::uint64_t* const table, const std::size_t num_words,
+                                      const std::uint64_t seed, const std::size_t num_updates)
+    {
+        const auto index_mask = static_cast<std::uint64_t>(num_words - 1);
+
+        auto ran = seed;
+        auto sum = std::uint64_t{0};
+        for (std::size_t i = 0; i < num_updates; ++i)
+        {
+            ran = detail::next_random(ran);
+            auto& word = table[ran & index_mask];
+
+            if constexpr (OPERATION == Operation::Read)
+            {
+                sum += word;
+            }
+            else if constexpr (OPERATION == Operation::Update)
+            {
+                word ^= ran;
+            }
+            else
+            {
+                __atomic_fetch_xor(&word, ran, __ATOMIC_RELAXED);
+            }
+        }
+        return sum;
+    }
+
+}  // namespace random_access
@@ -0,0 +1,138 @@
+#include "common.hpp"
+#include "jit.hpp"
+#include "perf_counter.h"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+
+namespace rob_capacity
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    // Each chain spans far more than the last-level cache, so every chain load misses
+    constexpr auto CHAIN_BUFFER_SIZE = 256 * common::MiB;
+
+    constexpr auto MAX_FILLERS = std::size_t{640};
+    constexpr auto FILLER_STEP = std::size_t{8};
+
+    struct BenchmarkResult
+    {
+        const common::MemoryBackend backend;
+        const Filler filler;
+        const std::size_t num_fillers;
+        const std::size_t num_iterations;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,Filler,NumFillers,NumIterations,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.backend) << "," << to_string(result.filler) << "," << result.num_fillers << ","
+                  << result.num_iterations << "," << result.cycle_count << "\n";
+    }
+
+    // `chain_positions` holds the current positions of the two chains and is advanced by every run
+    void run_benchmark(const common::MemoryBackend backend, const Filler filler, const std::size_t num_fillers,
+                       void** const chain_positions, void* const scratch)
+    {
+        constexpr auto NUM_ITERATIONS = std::size_t{20'000};
+        constexpr auto NUM_TRIALS = std::int32_t{5};
+        constexpr auto NUM_WARMUPS = std::int32_t{1};
+        constexpr auto MAX_FILLER_BYTES = std::size_t{3};
+
+        auto buffer = common::JitBuffer(2 * num_fillers * MAX_FILLER_BYTES + common::get_page_size(), false);
+        const auto kernel = generate_kernel(buffer, filler, num_fillers);
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        auto result = BenchmarkResult{backend, filler, num_fillers, NUM_ITERATIONS};
+
+        // Every trial continues where the previous one stopped, so it never revisits lines that are still cached
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_cycles = perf_counter_read(&cycle_counter);
+
+            kernel(NUM_ITERATIONS, chain_positions, scratch);
+
+            const auto end_cycles = perf_counter_read(&cycle_counter);
+
+            const auto cycles = end_cycles - start_cycles;
+            if (i >= NUM_WARMUPS && cycles < result.cycle_count)
+            {
+                result.cycle_count = cycles;
+            }
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+}  // namespace rob_capacity
+
+int main()
+{
+    constexpr auto SEED_A = std::uint64_t{12345};
+    constexpr auto SEED_B = std::uint64_t{67890};
+
+    rob_capacity::print_csv_header();
+
+    try
+    {
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+        const auto num_elements = rob_capacity::CHAIN_BUFFER_SIZE / cache_line_bytes;
+
+        auto scratch = common::allocate_aligned_buffer<std::uint64_t>(cache_line_bytes, cache_line_bytes);
+        std::memset(scratch.get(), 0, cache_line_bytes);
+
+        // The default THP keeps the misses from also being TLB misses
+        for (const auto backend : common::get_memory_backends({common::MemoryBackend::Thp}))
+        {
+            const auto buffer_a = common::MemoryBuffer(rob_capacity::CHAIN_BUFFER_SIZE, backend);
+            const auto buffer_b = common::MemoryBuffer(rob_capacity::CHAIN_BUFFER_SIZE, backend);
+
+            auto chain_positions = std::array<void*, 2>{
+                common::generate_random_pointer_chasing(buffer_a.data<common::MemoryAddress>(), num_elements,
+                                                        cache_line_bytes, SEED_A),
+                common::generate_random_pointer_chasing(buffer_b.data<common::MemoryAddress>(), num_elements,
+                                                        cache_line_bytes, SEED_B)};
+
+            for (const auto filler : {rob_capacity::Filler::Nop, rob_capacity::Filler::IndependentAdd,
+                                      rob_capacity::Filler::DependentAdd, rob_capacity::Filler::Load,
+                                      rob_capacity::Filler::Store})
+            {
+                for (std::size_t num_fillers = 0; num_fillers <= rob_capacity::MAX_FILLERS;
+                     num_fillers += rob_capacity::FILLER_STEP)
+                {
+                    rob_capacity::run_benchmark(backend, filler, num_fillers, chain_positions.data(), scratch.get());
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
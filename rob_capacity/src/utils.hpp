@@ -0,0 +1,127 @@
+#pragma once
+
+#include "jit.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Henry Wong's method: each iteration issues a cache-missing load from chain A, N fillers, a cache-missing load from
+// chain B and N more fillers. While A, the fillers and B fit in the structure the fillers occupy, the two misses
+// overlap and an iteration costs one memory latency; past that size it costs two.
+namespace rob_capacity
+{
+    enum class Filler
+    {
+        // Occupies reorder-buffer entries only
+        Nop,
+        // Independent of the misses, so it retires behind them while holding a reorder-buffer entry and a register
+        IndependentAdd,
+        // Depends on the preceding miss, so it also waits in the scheduler
+        DependentAdd,
+        // L1-hitting load; occupies a load-buffer entry
+        Load,
+        // L1-hitting store; occupies a store-buffer entry
+        Store,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Filler filler) noexcept
+    {
+        switch (filler)
+        {
+            case Filler::Nop:
+                return "Nop";
+            case Filler::IndependentAdd:
+                return "IndependentAdd";
+            case Filler::DependentAdd:
+                return "DependentAdd";
+            case Filler::Load:
+                return "Load";
+            case Filler::Store:
+                return "Store";
+        }
+        return "Unknown";
+    }
+
+    // Generated code takes the iteration count, the current positions of chains A and B, which it advances in place,
+    // and a scratch line for the load and store fillers
+    using KernelFunction = void (*)(std::uint64_t num_iterations, void** chain_positions, void* scratch);
+
+    namespace detail
+    {
+        constexpr auto CODE_ALIGNMENT = std::size_t{64};
+        constexpr auto INT3 = std::uint8_t{0xCC};
+        constexpr auto NOP = std::uint8_t{0x90};
+
+        // `miss_register` is the register of the preceding chain load: 0 for %rsi (chain A), 1 for %rdx (chain B)
+        inline void emit_filler(common::JitBuffer& buffer, const Filler filler, const std::int32_t miss_register)
+        {
+            switch (filler)
+            {
+                case Filler::Nop:
+                    buffer.emit({NOP});
+                    break;
+                case Filler::IndependentAdd:
+                    // add %r9, %r8
+                    buffer.emit({0x4D, 0x01, 0xC8});
+                    break;
+                case Filler::DependentAdd:
+                    // add %rsi, %r8 or add %rdx, %r8
+                    buffer.emit({0x49, 0x01, static_cast<std::uint8_t>(miss_register == 0 ? 0xF0 : 0xD0)});
+                    break;
+                case Filler::Load:
+                    // mov (%rcx), %r9
+                    buffer.emit({0x4C, 0x8B, 0x09});
+                    break;
+                case Filler::Store:
+                    // mov %r8, (%rcx)
+                    buffer.emit({0x4C, 0x89, 0x01});
+                    break;
+            }
+        }
+    }  // namespace detail
+
+    [[nodiscard]] inline KernelFunction generate_kernel(common::JitBuffer& buffer, const Filler filler,
+                                                        const std::size_t num_fillers)
+    {
+        buffer.align(detail::CODE_ALIGNMENT, detail::INT3);
+        const auto start = buffer.size();
+
+        // mov %rdx, %rcx; mov %rsi, %r10; mov 8(%r10), %rdx; mov (%r10), %rsi
+        buffer.emit({0x48, 0x89, 0xD1});
+        buffer.emit({0x49, 0x89, 0xF2});
+        buffer.emit({0x49, 0x8B, 0x52, 0x08});
+        buffer.emit({0x49, 0x8B, 0x32});
+
+        // Falls through into the loop
+        buffer.align(detail::CODE_ALIGNMENT, detail::NOP);
+        const auto loop = buffer.size();
+
+        // mov (%rsi), %rsi
+        buffer.emit({0x48, 0x8B, 0x36});
+        for (std::size_t i = 0; i < num_fillers; ++i)
+        {
+            detail::emit_filler(buffer, filler, 0);
+        }
+
+        // mov (%rdx), %rdx
+        buffer.emit({0x48, 0x8B, 0x12});
+        for (std::size_t i = 0; i < num_fillers; ++i)
+        {
+            detail::emit_filler(buffer, filler, 1);
+        }
+
+        // dec %rdi; jnz <loop>
+        buffer.emit({0x48, 0xFF, 0xCF});
+        buffer.emit({0x0F, 0x85});
+        buffer.emit_rel32(loop);
+
+        // mov %rsi, (%r10); mov %rdx, 8(%r10); ret
+        buffer.emit({0x49, 0x89, 0x32});
+        buffer.emit({0x49, 0x89, 0x52, 0x08});
+        buffer.emit({0xC3});
+
+        buffer.finalize();
+        return buffer.get_function<KernelFunction>(start);
+    }
+
+}  // namespace rob_capacity
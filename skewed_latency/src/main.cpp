@@ -0,0 +1,187 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace skewed_latency
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    constexpr auto NUM_LOGICAL_LOADS = std::int32_t{1'000'000};
+
+    // Zipfian:0 is the uniform baseline that `memory_latency` measures with a plain chain
+    const auto DEFAULT_DISTRIBUTIONS = std::vector<Distribution>{
+        {DistributionKind::Zipfian, 0.0},
+        {DistributionKind::Zipfian, 0.5},
+        {DistributionKind::Zipfian, 0.99},
+        {DistributionKind::Zipfian, 1.2},
+        {DistributionKind::HotSet, 0.0, 0.1, 0.9},
+        {DistributionKind::HotSet, 0.0, 0.01, 0.99},
+    };
+
+    struct BenchmarkResult
+    {
+        const std::string& distribution;
+        const common::MemoryBackend backend;
+        const std::size_t buffer_size;
+        const std::size_t num_visits;
+        const std::vector<double>& hot_shares;
+        const std::int32_t num_logical_loads;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Distribution,MemoryBackend,BufferSize,NumVisits,L1DHotShare,L2HotShare,L3HotShare,"
+                     "NumLogicalLoads,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << result.distribution << "," << to_string(result.backend) << "," << result.buffer_size << ","
+                  << result.num_visits;
+        for (const auto share : result.hot_shares)
+        {
+            std::cout << "," << share;
+        }
+        std::cout << "," << result.num_logical_loads << "," << result.cycle_count << "\n";
+    }
+
+    // Capacity in elements of the L1D, L2 and L3, or 0 where the size is unknown
+    [[nodiscard]] std::vector<std::size_t> get_cache_capacities(const std::size_t padded_bytes_per_element)
+    {
+        auto capacities = std::vector<std::size_t>();
+        for (const auto name : {_SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE})
+        {
+            capacities.push_back(static_cast<std::size_t>(std::max(sysconf(name), 0L)) / padded_bytes_per_element);
+        }
+        return capacities;
+    }
+
+    void run_benchmark(const Distribution& distribution, const common::MemoryBackend backend,
+                       const std::size_t buffer_size_in_bytes, const std::size_t padded_bytes_per_element)
+    {
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+        constexpr auto RAND_SEED = std::uint64_t{12345};
+
+        const auto num_elements = buffer_size_in_bytes / padded_bytes_per_element;
+
+        // At least one visit per element, so that a lap reaches the whole distribution; whole trials per lap
+        const auto num_visits =
+            ((std::max(num_elements, std::size_t{NUM_LOGICAL_LOADS}) + NUM_LOGICAL_LOADS - 1) / NUM_LOGICAL_LOADS) *
+            NUM_LOGICAL_LOADS;
+
+        const auto buffer = common::MemoryBuffer(buffer_size_in_bytes, backend);
+        auto* const elements = buffer.data<common::MemoryAddress>();
+
+        const auto offsets =
+            distribution.kind == DistributionKind::Zipfian
+                ? common::generate_zipfian_visits(elements, num_elements, padded_bytes_per_element, num_visits,
+                                                  distribution.skew, RAND_SEED)
+                : common::generate_hot_set_visits(elements, num_elements, padded_bytes_per_element, num_visits,
+                                                  distribution.hot_fraction, distribution.hot_probability,
+                                                  RAND_SEED);
+
+        const auto name = to_string(distribution);
+        const auto hot_shares = get_hot_shares(offsets, padded_bytes_per_element, num_elements,
+                                               get_cache_capacities(padded_bytes_per_element));
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            throw std::runtime_error("Failed to open performance counter for event '" + std::string(CYCLES_EVENT) +
+                                     "'.");
+        }
+
+        auto* volatile kernel = common::walk_visits<NUM_LOGICAL_LOADS>;
+
+        // One lap brings the caches to their steady state; every trial then continues where the previous one stopped
+        for (std::size_t visit = 0; visit < num_visits; visit += NUM_LOGICAL_LOADS)
+        {
+            kernel(elements, offsets.data() + visit);
+        }
+
+        auto result = BenchmarkResult{name, backend, buffer_size_in_bytes, num_visits, hot_shares, NUM_LOGICAL_LOADS};
+        auto visit = std::size_t{0};
+
+        perf_counter_enable(&cycle_counter);
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_cycles = perf_counter_read(&cycle_counter);
+
+            kernel(elements, offsets.data() + visit);
+
+            const auto end_cycles = perf_counter_read(&cycle_counter);
+
+            visit = (visit + NUM_LOGICAL_LOADS) % num_visits;
+            if (i >= NUM_WARMUPS)
+            {
+                result.cycle_count = std::min(result.cycle_count, end_cycles - start_cycles);
+            }
+        }
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+}  // namespace skewed_latency
+
+// Usage: skewed_latency [distribution...]
+// Sweeps the buffer size for each distribution (see `skewed_latency::parse_distribution`), or for a default set, and
+// each memory backend (see `common::get_memory_backends`), by default THP.
+int main(int argc, char* argv[])
+{
+    skewed_latency::print_csv_header();
+
+    constexpr auto MIN_BUFFER_SIZE = 16 * common::KiB;
+    constexpr auto MAX_BUFFER_SIZE = 1 * common::GiB;
+
+    try
+    {
+        auto distributions = std::vector<skewed_latency::Distribution>();
+        for (int i = 1; i < argc; ++i)
+        {
+            distributions.push_back(skewed_latency::parse_distribution(argv[i]));
+        }
+        if (distributions.empty())
+        {
+            distributions = skewed_latency::DEFAULT_DISTRIBUTIONS;
+        }
+
+        common::pin_current_thread_to_cpu(common::get_available_cpus().front());
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+        const auto backends = common::get_memory_backends({common::MemoryBackend::Thp});
+
+        for (const auto& distribution : distributions)
+        {
+            for (const auto backend : backends)
+            {
+                for (auto size = MIN_BUFFER_SIZE; size <= MAX_BUFFER_SIZE; size *= 2)
+                {
+                    skewed_latency::run_benchmark(distribution, backend, size, cache_line_bytes);
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace skewed_latency
+{
+    enum class DistributionKind
+    {
+        Zipfian,
+        HotSet,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const DistributionKind kind) noexcept
+    {
+        switch (kind)
+        {
+            case DistributionKind::Zipfian:
+                return "Zipfian";
+            case DistributionKind::HotSet:
+                return "HotSet";
+        }
+        return "Unknown";
+    }
+
+    // `skew` applies to `Zipfian`, `hot_fraction` and `hot_probability` to `HotSet`
+    struct Distribution
+    {
+        DistributionKind kind = DistributionKind::Zipfian;
+        double skew = 0.0;
+        double hot_fraction = 0.0;
+        double hot_probability = 0.0;
+    };
+
+    // "Zipfian:<skew>" or "HotSet:<hot fraction>:<hot probability>", e.g. "Zipfian:0.99" or "HotSet:0.1:0.9"
+    [[nodiscard]] inline Distribution parse_distribution(const std::string& spec)
+    {
+        const auto first_colon = spec.find(':');
+        if (first_colon == std::string::npos)
+        {
+            throw std::invalid_argument("Distribution '" + spec + "' has no parameters.");
+        }
+
+        const auto kind_name = spec.substr(0, first_colon);
+        const auto parameters = spec.substr(first_colon + 1);
+        auto distribution = Distribution{};
+        if (kind_name == to_string(DistributionKind::Zipfian))
+        {
+            distribution.kind = DistributionKind::Zipfian;
+            distribution.skew = std::stod(parameters);
+        }
+        else if (kind_name == to_string(DistributionKind::HotSet))
+        {
+            const auto second_colon = parameters.find(':');
+            if (second_colon == std::string::npos)
+            {
+                throw std::invalid_argument("Distribution '" + spec + "' needs a hot fraction and probability.");
+            }
+            distribution.kind = DistributionKind::HotSet;
+            distribution.hot_fraction = std::stod(parameters.substr(0, second_colon));
+            distribution.hot_probability = std::stod(parameters.substr(second_colon + 1));
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown distribution '" + kind_name + "'.");
+        }
+        return distribution;
+    }
+
+    // Canonical form of the distribution for CSV columns
+    [[nodiscard]] inline std::string to_string(const Distribution& distribution)
+    {
+        auto stream = std::ostringstream();
+        stream << to_string(distribution.kind) << ":";
+        if (distribution.kind == DistributionKind::Zipfian)
+        {
+            stream << distribution.skew;
+        }
+        else
+        {
+            stream << distribution.hot_fraction << ":" << distribution.hot_probability;
+        }
+        return stream.str();
+    }
+
+    // Shares of the visits that go to the `num_hot_elements[i]` most visited elements: the hit rates of ideal caches
+    // of those capacities, against which the measured latencies can be read
+    [[nodiscard]] inline std::vector<double> get_hot_shares(const std::vector<std::uint32_t>& offsets,
+                                                            const std::size_t padded_bytes_per_element,
+                                                            const std::size_t num_elements,
+                                                            const std::vector<std::size_t>& num_hot_elements)
+    {
+        auto counts = std::vector<std::uint64_t>(num_elements, 0);
+        for (const auto offset : offsets)
+        {
+            ++counts[offset / padded_bytes_per_element];
+        }
+        std::sort(counts.begin(), counts.end(), std::greater<>());
+
+        auto shares = std::vector<double>();
+        for (const auto num_hot : num_hot_elements)
+        {
+            auto num_hot_visits = std::uint64_t{0};
+            for (std::size_t i = 0; i < std::min(num_hot, num_elements); ++i)
+            {
+                num_hot_visits += counts[i];
+            }
+            shares.push_back(static_cast<double>(num_hot_visits) / static_cast<double>(offsets.size()));
+        }
+        return shares;
+    }
+
+}  // namespace skewed_latency
@@ -0,0 +1,203 @@
+#include "antagonist.hpp"
+#include "common.hpp"
+#include "perf_counter.h"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace smt_interference
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    // The antagonist's own chain, large enough that every step goes to DRAM
+    constexpr auto ANTAGONIST_CHASE_SIZE = 256 * common::MiB;
+
+    // Roughly L1-, L2-, L3- and DRAM-resident victim chains
+    constexpr std::size_t VICTIM_CHASE_SIZES[] = {16 * common::KiB, 512 * common::KiB, 8 * common::MiB,
+                                                  512 * common::MiB};
+
+    constexpr auto NUM_CHASE_STEPS = std::int32_t{1'000'000};
+    constexpr auto NUM_ADD_BLOCKS = std::int32_t{1'000};
+
+    // `None` comes first: it is the baseline of the slowdowns
+    const auto ANTAGONISTS = std::vector<Antagonist>{
+        Antagonist::None,
+        Antagonist::Alu,
+        Antagonist::Load,
+        Antagonist::Store,
+#if defined(__AVX2__) && defined(__FMA__)
+        Antagonist::Avx2,
+#endif
+#ifdef __AVX512F__
+        Antagonist::Avx512,
+#endif
+        Antagonist::Chase,
+    };
+
+    struct BenchmarkResult
+    {
+        const common::MemoryBackend backend;
+        const Victim victim;
+        const std::size_t buffer_size;
+        const Antagonist antagonist;
+        const std::int64_t num_operations;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+        double slowdown = 1.0;
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "MemoryBackend,Victim,BufferSize,Antagonist,NumOperations,Cycles,Slowdown\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << to_string(result.backend) << "," << to_string(result.victim) << "," << result.buffer_size << ","
+                  << to_string(result.antagonist) << "," << result.num_operations << "," << result.cycle_count << ","
+                  << result.slowdown << "\n";
+    }
+
+    // Runs `function` on the calling thread while `antagonist` runs on `sibling_cpu`; returns the minimum cycle count
+    template <typename Function>
+    [[nodiscard]] std::uint64_t measure_cycles(const Antagonist antagonist, const std::int32_t sibling_cpu,
+                                               const AntagonistContext& context, Function&& function)
+    {
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            throw std::runtime_error("Failed to open performance counter for event '" + std::string(CYCLES_EVENT) +
+                                     "'.");
+        }
+
+        auto min_cycles = std::numeric_limits<std::uint64_t>::max();
+        {
+            const auto antagonist_thread =
+                common::BackgroundThreads({sibling_cpu}, [&](std::size_t, const std::atomic<bool>& stop) {
+                    run_antagonist(antagonist, context, stop);
+                });
+
+            perf_counter_enable(&cycle_counter);
+            for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+            {
+                const auto start_cycles = perf_counter_read(&cycle_counter);
+
+                function();
+
+                const auto end_cycles = perf_counter_read(&cycle_counter);
+
+                if (i >= NUM_WARMUPS)
+                {
+                    min_cycles = std::min(min_cycles, end_cycles - start_cycles);
+                }
+            }
+            perf_counter_disable(&cycle_counter);
+        }
+
+        perf_counter_close(&cycle_counter);
+        return min_cycles;
+    }
+
+    // Measures the victim under every antagonist; each slowdown is relative to the run without one. `backend` is that
+    // of the victim's and the chasing antagonist's buffers.
+    template <typename Function>
+    void run_benchmark(const common::MemoryBackend backend, const Victim victim, const std::size_t buffer_size,
+                       const std::int64_t num_operations, const std::int32_t sibling_cpu,
+                       const AntagonistContext& context, Function&& function)
+    {
+        auto baseline_cycles = std::uint64_t{0};
+        for (const auto antagonist : ANTAGONISTS)
+        {
+            auto result = BenchmarkResult{backend, victim, buffer_size, antagonist, num_operations};
+            result.cycle_count = measure_cycles(antagonist, sibling_cpu, context, function);
+            if (antagonist == Antagonist::None)
+            {
+                baseline_cycles = result.cycle_count;
+            }
+            result.slowdown = static_cast<double>(result.cycle_count) / static_cast<double>(baseline_cycles);
+
+            print_csv_row(result);
+        }
+    }
+
+    [[nodiscard]] std::int32_t find_smt_sibling(const std::vector<std::int32_t>& cpus)
+    {
+        const auto first = common::get_cpu_location(cpus.front());
+        const auto it = std::find_if(cpus.begin(), cpus.end(), [&](const std::int32_t cpu) {
+            return common::get_cpu_relation(first, common::get_cpu_location(cpu)) == common::CpuRelation::SmtSibling;
+        });
+        if (it == cpus.end())
+        {
+            throw std::runtime_error("No SMT sibling of CPU " + std::to_string(cpus.front()) + " is available.");
+        }
+        return *it;
+    }
+
+}  // namespace smt_interference
+
+int main()
+{
+    constexpr auto RAND_SEED = std::uint64_t{12345};
+    constexpr auto ANTAGONIST_SEED = std::uint64_t{67890};
+
+    smt_interference::print_csv_header();
+
+    try
+    {
+        const auto cpus = common::get_available_cpus();
+        const auto sibling_cpu = smt_interference::find_smt_sibling(cpus);
+        common::pin_current_thread_to_cpu(cpus.front());
+
+        const auto cache_line_bytes = common::get_cache_line_bytes();
+
+        auto scratch = common::allocate_aligned_buffer<std::uint64_t>(cache_line_bytes, cache_line_bytes);
+        std::memset(scratch.get(), 0, cache_line_bytes);
+
+        for (const auto backend : common::get_memory_backends({common::MemoryBackend::Thp}))
+        {
+            const auto antagonist_buffer = common::MemoryBuffer(smt_interference::ANTAGONIST_CHASE_SIZE, backend);
+            const auto context = smt_interference::AntagonistContext{
+                scratch.get(), common::generate_random_pointer_chasing(
+                                   antagonist_buffer.data<common::MemoryAddress>(),
+                                   smt_interference::ANTAGONIST_CHASE_SIZE / cache_line_bytes, cache_line_bytes,
+                                   ANTAGONIST_SEED)};
+
+            for (const auto size : smt_interference::VICTIM_CHASE_SIZES)
+            {
+                const auto buffer = common::MemoryBuffer(size, backend);
+                auto* const start_ptr = common::generate_random_pointer_chasing(
+                    buffer.data<common::MemoryAddress>(), size / cache_line_bytes, cache_line_bytes, RAND_SEED);
+
+                auto* volatile kernel = common::walk_pointer_chain<smt_interference::NUM_CHASE_STEPS>;
+                smt_interference::run_benchmark(backend, smt_interference::Victim::Chase, size,
+                                                smt_interference::NUM_CHASE_STEPS, sibling_cpu, context,
+                                                [&] { kernel(start_ptr); });
+            }
+
+            smt_interference::run_benchmark(
+                backend, smt_interference::Victim::AluThroughput, 0,
+                std::int64_t{smt_interference::NUM_ADD_BLOCKS} * smt_interference::ADDS_PER_BLOCK, sibling_cpu,
+                context, [] { smt_interference::execute_adds(smt_interference::NUM_ADD_BLOCKS); });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "common.hpp"
+#include "pointer_chasing.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#define REP10(x) x x x x x x x x x x
+#define REP100(x) REP10(REP10(x))
+#define REP1000(x) REP10(REP100(x))
+
+namespace smt_interference
+{
+    enum class Antagonist
+    {
+        None,
+        // Independent adds on four registers; competes for the integer ports
+        Alu,
+        // Independent L1-hitting loads; competes for the load ports and the L1D
+        Load,
+        // L1-hitting stores; competes for the store port and the store buffer
+        Store,
+        // 256-bit FMAs on ten accumulators, enough independent chains to fill the FMA ports
+        Avx2,
+        // 512-bit FMAs on ten accumulators; may also lower the core frequency
+        Avx512,
+        // Pointer chase through DRAM; competes for the line fill buffers and the private caches
+        Chase,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Antagonist antagonist) noexcept
+    {
+        switch (antagonist)
+        {
+            case Antagonist::None:
+                return "None";
+            case Antagonist::Alu:
+                return "Alu";
+            case Antagonist::Load:
+                return "Load";
+            case Antagonist::Store:
+                return "Store";
+            case Antagonist::Avx2:
+                return "Avx2";
+            case Antagonist::Avx512:
+                return "Avx512";
+            case Antagonist::Chase:
+                return "Chase";
+        }
+        return "Unknown";
+    }
+
+    enum class Victim
+    {
+        // Dependent loads; measures latency
+        Chase,
+        // Four independent add chains; measures throughput
+        AluThroughput,
+    };
+
+    [[nodiscard]] constexpr const char* to_string(const Victim victim) noexcept
+    {
+        switch (victim)
+        {
+            case Victim::Chase:
+                return "Chase";
+            case Victim::AluThroughput:
+                return "AluThroughput";
+        }
+        return "Unknown";
+    }
+
+    constexpr auto ADDS_PER_BLOCK = std::int32_t{4000};
+
+    // Runs `num_blocks * ADDS_PER_BLOCK` adds
+    inline void execute_adds(const std::int32_t num_blocks)
+    {
+        auto a = std::uint64_t{1};
+        auto b = std::uint64_t{2};
+        auto c = std::uint64_t{3};
+        auto d = std::uint64_t{4};
+        for (std::int32_t i = 0; i < num_blocks; ++i)
+        {
+            __asm__ volatile(REP1000("add %0, %0\n\tadd %1, %1\n\tadd %2, %2\n\tadd %3, %3\n\t")
+                             : "+r"(a), "+r"(b), "+r"(c), "+r"(d));
+        }
+    }
+
+    // State the antagonist loops work on; `scratch` is an L1-resident line and `chase_start` a DRAM-sized chain
+    struct AntagonistContext
+    {
+        std::uint64_t* scratch;
+        common::MemoryAddress* chase_start;
+    };
+
+    // Repeats blocks of the antagonist's work until `stop` is set
+    inline void run_antagonist(const Antagonist antagonist, const AntagonistContext& context,
+                               const std::atomic<bool>& stop)
+    {
+        auto* chase_ptr = context.chase_start;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            switch (antagonist)
+            {
+                case Antagonist::None:
+                    return;
+                case Antagonist::Alu:
+                    execute_adds(1);
+                    break;
+                case Antagonist::Load:
+                    __asm__ volatile(REP100("mov (%0), %%rax\n\tmov 8(%0), %%rcx\n\t")
+                                     :
+                                     : "r"(context.scratch)
+                                     : "rax", "rcx", "memory");
+                    break;
+                case Antagonist::Store:
+                    __asm__ volatile(REP100("mov %%rax, (%0)\n\tmov %%rax, 8(%0)\n\t")
+                                     :
+                                     : "r"(context.scratch)
+                                     : "memory");
+                    break;
+                case Antagonist::Avx2:
+#if defined(__AVX2__) && defined(__FMA__)
+                    // Zeroed operands keep denormal assists out of the loop
+                    __asm__ volatile("vxorps %%ymm1, %%ymm1, %%ymm1\n\t"
+                                     "vxorps %%ymm2, %%ymm2, %%ymm2\n\t"
+                                     "vxorps %%ymm3, %%ymm3, %%ymm3\n\t"
+                                     "vxorps %%ymm4, %%ymm4, %%ymm4\n\t"
+                                     "vxorps %%ymm5, %%ymm5, %%ymm5\n\t"
+                                     "vxorps %%ymm6, %%ymm6, %%ymm6\n\t"
+                                     "vxorps %%ymm7, %%ymm7, %%ymm7\n\t"
+                                     "vxorps %%ymm8, %%ymm8, %%ymm8\n\t"
+                                     "vxorps %%ymm9, %%ymm9, %%ymm9\n\t"
+                                     "vxorps %%ymm10, %%ymm10, %%ymm10\n\t"
+                                     "vxorps %%ymm11, %%ymm11, %%ymm11\n\t"
+                                     REP10("vfmadd231ps %%ymm1, %%ymm1, %%ymm2\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm3\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm4\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm5\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm6\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm7\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm8\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm9\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm10\n\t"
+                                           "vfmadd231ps %%ymm1, %%ymm1, %%ymm11\n\t")
+                                     :
+                                     :
+                                     : "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7", "xmm8",
+                                       "xmm9", "xmm10", "xmm11");
+#endif
+                    break;
+                case Antagonist::Avx512:
+#ifdef __AVX512F__
+                    // Zeroed operands keep denormal assists out of the loop
+                    __asm__ volatile("vpxord %%zmm1, %%zmm1, %%zmm1\n\t"
+                                     "vpxord %%zmm2, %%zmm2, %%zmm2\n\t"
+                                     "vpxord %%zmm3, %%zmm3, %%zmm3\n\t"
+                                     "vpxord %%zmm4, %%zmm4, %%zmm4\n\t"
+                                     "vpxord %%zmm5, %%zmm5, %%zmm5\n\t"
+                                     "vpxord %%zmm6, %%zmm6, %%zmm6\n\t"
+                                     "vpxord %%zmm7, %%zmm7, %%zmm7\n\t"
+                                     "vpxord %%zmm8, %%zmm8, %%zmm8\n\t"
+                                     "vpxord %%zmm9, %%zmm9, %%zmm9\n\t"
+                                     "vpxord %%zmm10, %%zmm10, %%zmm10\n\t"
+                                     "vpxord %%zmm11, %%zmm11, %%zmm11\n\t"
+                                     REP10("vfmadd231ps %%zmm1, %%zmm1, %%zmm2\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm3\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm4\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm5\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm6\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm7\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm8\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm9\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm10\n\t"
+                                           "vfmadd231ps %%zmm1, %%zmm1, %%zmm11\n\t")
+                                     :
+                                     :
+                                     : "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7", "xmm8",
+                                       "xmm9", "xmm10", "xmm11");
+#endif
+                    break;
+                case Antagonist::Chase:
+                    chase_ptr = common::walk_pointer_chain<1000>(chase_ptr);
+                    break;
+            }
+        }
+    }
+
+}  // namespace smt_interference
+
+#undef REP1000
+#undef REP100
+#undef REP10
@@ -0,0 +1,164 @@
+#include "common.hpp"
+#include "perf_counter.h"
+#include "pointer_chasing.hpp"
+#include "utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace store_forwarding
+{
+    constexpr auto CYCLES_EVENT = "CYCLES";
+
+    constexpr auto NUM_STEPS = std::int32_t{1'000'000};
+
+    // The chased element sits this far into the buffer so that every store distance below stays inside it
+    constexpr auto ELEMENT_OFFSET = std::size_t{64 * 1024};
+    constexpr auto BUFFER_SIZE = 2 * ELEMENT_OFFSET;
+
+    using ForwardingKernel = std::uint64_t (*)(unsigned char*);
+    using AliasingKernel = common::MemoryAddress* (*)(common::MemoryAddress*);
+
+    struct ForwardingKernelInfo
+    {
+        const char* name;
+        ForwardingKernel kernel;
+    };
+
+    struct AliasingKernelInfo
+    {
+        // Negative for the plain chain without stores
+        std::int32_t store_distance;
+        AliasingKernel kernel;
+    };
+
+#define STORE_FORWARDING_ENTRY(NAME, FUNCTION) ForwardingKernelInfo{NAME, FUNCTION<NUM_STEPS>}
+
+    constexpr ForwardingKernelInfo FORWARDING_KERNELS[] = {
+        STORE_FORWARDING_ENTRY("Store64Load64", store64_load64),
+        STORE_FORWARDING_ENTRY("Store32Load32", store32_load32),
+        STORE_FORWARDING_ENTRY("Store16Load16", store16_load16),
+        STORE_FORWARDING_ENTRY("Store8Load8", store8_load8),
+        STORE_FORWARDING_ENTRY("Store64Load32", store64_load32),
+        STORE_FORWARDING_ENTRY("Store64Load32Offset4", store64_load32_offset4),
+        STORE_FORWARDING_ENTRY("Store64Load8Offset5", store64_load8_offset5),
+        STORE_FORWARDING_ENTRY("Store32Load64", store32_load64),
+        STORE_FORWARDING_ENTRY("Store64Load64Offset4", store64_load64_offset4),
+        STORE_FORWARDING_ENTRY("TwoStore32Load64", two_store32_load64),
+        STORE_FORWARDING_ENTRY("Store64Load64LineSplit", store64_load64_line_split),
+    };
+
+#undef STORE_FORWARDING_ENTRY
+
+    // Multiples of 4 KiB alias the load; 64 and 4160 are same-page and next-page controls that do not
+    constexpr AliasingKernelInfo ALIASING_KERNELS[] = {
+        {-1, common::walk_pointer_chain<NUM_STEPS>},
+        {0, walk_pointer_chain_with_store<NUM_STEPS, 0>},
+        {64, walk_pointer_chain_with_store<NUM_STEPS, 64>},
+        {4096, walk_pointer_chain_with_store<NUM_STEPS, 4096>},
+        {4160, walk_pointer_chain_with_store<NUM_STEPS, 4160>},
+        {8192, walk_pointer_chain_with_store<NUM_STEPS, 8192>},
+        {65536, walk_pointer_chain_with_store<NUM_STEPS, 65536>},
+    };
+
+    struct BenchmarkResult
+    {
+        const char* const kernel;
+        const std::string variant;
+        const std::int32_t num_steps;
+        std::uint64_t cycle_count = std::numeric_limits<uint64_t>::max();
+    };
+
+    void print_csv_header()
+    {
+        std::cout << "Kernel,Variant,NumSteps,Cycles\n";
+    }
+
+    void print_csv_row(const BenchmarkResult& result)
+    {
+        std::cout << result.kernel << "," << result.variant << "," << result.num_steps << "," << result.cycle_count
+                  << "\n";
+    }
+
+    template <typename Function>
+    void run_benchmark(BenchmarkResult result, Function&& function)
+    {
+        constexpr auto NUM_TRIALS = std::int32_t{10};
+        constexpr auto NUM_WARMUPS = std::int32_t{3};
+
+        auto cycle_counter = perf_counter_open_by_name(CYCLES_EVENT, -1);
+        if (!perf_counter_is_valid(&cycle_counter))
+        {
+            std::cerr << "Error: Failed to open performance counter for event '" << CYCLES_EVENT << "'.\n";
+            return;
+        }
+
+        perf_counter_enable(&cycle_counter);
+
+        for (std::int32_t i = 0; i < NUM_WARMUPS + NUM_TRIALS; ++i)
+        {
+            const auto start_cycles = perf_counter_read(&cycle_counter);
+
+            function();
+
+            const auto end_cycles = perf_counter_read(&cycle_counter);
+
+            const auto cycles = end_cycles - start_cycles;
+            if (i >= NUM_WARMUPS && cycles < result.cycle_count)
+            {
+                result.cycle_count = cycles;
+            }
+        }
+
+        perf_counter_disable(&cycle_counter);
+        perf_counter_close(&cycle_counter);
+
+        print_csv_row(result);
+    }
+
+}  // namespace store_forwarding
+
+int main()
+{
+    store_forwarding::print_csv_header();
+
+    try
+    {
+        const auto page_size = common::get_page_size();
+
+        auto buffer = common::allocate_aligned_buffer<unsigned char>(store_forwarding::BUFFER_SIZE, page_size);
+
+        // The forwarding kernels work on the first line; the line-split kernel also touches the second one
+        for (const auto& info : store_forwarding::FORWARDING_KERNELS)
+        {
+            auto* volatile kernel = info.kernel;
+            store_forwarding::run_benchmark({"StoreForwarding", info.name, store_forwarding::NUM_STEPS},
+                                            [&] { kernel(buffer.get()); });
+        }
+
+        // A single element that points to itself: every step loads the same L1-resident address
+        auto* const element =
+            reinterpret_cast<common::MemoryAddress*>(buffer.get() + store_forwarding::ELEMENT_OFFSET);
+        *element = element;
+
+        for (const auto& info : store_forwarding::ALIASING_KERNELS)
+        {
+            auto* volatile kernel = info.kernel;
+            const auto variant = info.store_distance < 0 ? std::string("NoStore")
+                                                         : "StoreDistance" + std::to_string(info.store_distance);
+            store_forwarding::run_benchmark({"Aliasing", variant, store_forwarding::NUM_STEPS},
+                                            [&] { kernel(element); });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
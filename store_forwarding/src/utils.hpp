@@ -0,0 +1,80 @@
+#pragma once
+
+#include "pointer_chasing.hpp"
+
+#include <cstdint>
+
+#define REP10(x) x x x x x x x x x x
+#define REP100(x) REP10(REP10(x))
+#define REP1000(x) REP10(REP100(x))
+
+namespace store_forwarding
+{
+    constexpr auto UNROLL_COUNT = std::int32_t{1000};
+
+    // Each step stores `value` and loads it back (or part of it) from a fixed address, so the steps form a dependent
+    // chain through memory whose per-step latency is the store-to-load forwarding latency, or the store-commit-and-
+    // reload penalty when forwarding fails
+#define STORE_FORWARDING_DEFINE(NAME, STEP_ASM)                                                                        \
+    template <std::int32_t NUM_STEPS>                                                                                  \
+    std::uint64_t NAME(unsigned char* const buffer)                                                                    \
+    {                                                                                                                  \
+        static_assert(NUM_STEPS % UNROLL_COUNT == 0, "`NUM_STEPS` must be a multiple of `UNROLL_COUNT`");             \
+                                                                                                                       \
+        auto value = std::uint64_t{0};                                                                                 \
+        for (std::int32_t i = 0; i < NUM_STEPS; i += UNROLL_COUNT)                                                     \
+        {                                                                                                              \
+            __asm__ volatile(REP1000(STEP_ASM) : [value] "+r"(value) : [buffer] "r"(buffer) : "memory");               \
+        }                                                                                                              \
+        return value;                                                                                                  \
+    }
+
+    // Same size and address
+    STORE_FORWARDING_DEFINE(store64_load64, "mov %[value], (%[buffer])\n\tmov (%[buffer]), %[value]\n\t")
+    STORE_FORWARDING_DEFINE(store32_load32, "mov %k[value], (%[buffer])\n\tmov (%[buffer]), %k[value]\n\t")
+    STORE_FORWARDING_DEFINE(store16_load16, "mov %w[value], (%[buffer])\n\tmovzwl (%[buffer]), %k[value]\n\t")
+    STORE_FORWARDING_DEFINE(store8_load8, "mov %b[value], (%[buffer])\n\tmovzbl (%[buffer]), %k[value]\n\t")
+
+    // Load contained in the store
+    STORE_FORWARDING_DEFINE(store64_load32, "mov %[value], (%[buffer])\n\tmov (%[buffer]), %k[value]\n\t")
+    STORE_FORWARDING_DEFINE(store64_load32_offset4, "mov %[value], (%[buffer])\n\tmov 4(%[buffer]), %k[value]\n\t")
+    STORE_FORWARDING_DEFINE(store64_load8_offset5, "mov %[value], (%[buffer])\n\tmovzbl 5(%[buffer]), %k[value]\n\t")
+
+    // Load only partially covered by the store (or by two stores), which cannot forward
+    STORE_FORWARDING_DEFINE(store32_load64, "mov %k[value], (%[buffer])\n\tmov (%[buffer]), %[value]\n\t")
+    STORE_FORWARDING_DEFINE(store64_load64_offset4, "mov %[value], (%[buffer])\n\tmov 4(%[buffer]), %[value]\n\t")
+    STORE_FORWARDING_DEFINE(two_store32_load64, "mov %k[value], (%[buffer])\n\tmov %k[value], 4(%[buffer])\n\t"
+                                                "mov (%[buffer]), %[value]\n\t")
+
+    // Same size and address, split across two cache lines
+    STORE_FORWARDING_DEFINE(store64_load64_line_split, "mov %[value], 60(%[buffer])\n\tmov 60(%[buffer]), %[value]\n\t")
+
+#undef STORE_FORWARDING_DEFINE
+
+    // Like `common::walk_pointer_chain`, but every step first stores the current pointer `STORE_DISTANCE` bytes below
+    // the element it is about to load. A distance that is a multiple of 4 KiB matches the load in the address bits the
+    // memory disambiguator compares first, so the load falsely waits on the store; a distance of 0 forwards the
+    // pointer from the store.
+    template <std::int32_t NUM_STEPS, std::int32_t STORE_DISTANCE>
+    common::MemoryAddress* walk_pointer_chain_with_store(common::MemoryAddress* const start_ptr)
+    {
+        static_assert(NUM_STEPS % UNROLL_COUNT == 0, "`NUM_STEPS` must be a multiple of `UNROLL_COUNT`");
+
+        auto* current_ptr = start_ptr;
+        for (std::int32_t i = 0; i < NUM_STEPS; i += UNROLL_COUNT)
+        {
+            // *(current_ptr - STORE_DISTANCE) = current_ptr; current_ptr = *current_ptr
+            __asm__ volatile(REP1000("mov %[ptr], -%c[distance](%[ptr])\n\t"
+                                     "mov (%[ptr]), %[ptr]\n\t")
+                             : [ptr] "+r"(current_ptr)
+                             : [distance] "i"(STORE_DISTANCE)
+                             : "memory");
+        }
+        return current_ptr;
+    }
+
+}  // namespace store_forwarding
+
+#undef REP1000
+#undef REP100
+#undef REP10